@@ -20,142 +20,106 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cmath>
 #include <math.h>
 #include "Player.hpp"
 
+// keep the player small, so big tournaments stay cache friendly
+static_assert(sizeof(CPPDubovSystem::Player) <= 256, "Player should be kept under 256 bytes");
+
+std::shared_ptr<const std::string> CPPDubovSystem::NamePool::intern(const std::string &name) {
+    std::unordered_map<std::string_view, std::shared_ptr<const std::string>>::iterator found = this->names.find(name);
+    if(found != this->names.end()) {
+        return found->second;
+    }
+    // the key views the pooled copy, which never moves
+    std::shared_ptr<const std::string> pooled = std::make_shared<const std::string>(name);
+    this->names[*pooled] = pooled;
+    return pooled;
+}
+
 CPPDubovSystem::Player::Player(std::string name, int rating, int id, double points) {
-    this->name = name;
+    this->name = std::make_shared<const std::string>(std::move(name));
+    this->rating = rating;
+    this->id = id;
+    this->half_points = (int) std::lround(points * 2.0);
+}
+
+CPPDubovSystem::Player::Player(const std::string &name, int rating, int id, double points, NamePool &names) {
+    this->name = names.intern(name);
     this->rating = rating;
     this->id = id;
-    this->points = points;
+    this->half_points = (int) std::lround(points * 2.0);
 }
 
 CPPDubovSystem::Player::Player() {
-    this->name = "UNNAMED PLAYER";
     this->rating = 0;
     this->id = -1;
-    this->points = 0.0;
+    this->half_points = 0;
 }
 
-CPPDubovSystem::Color CPPDubovSystem::Player::getDueColor() {
-    // check if already saved
-    if(this->has_saved_color) {
-        return this->due_color_saved;
-    }
-    int num_white = 0;
-    int num_black = 0;
-    std::vector<Color> storage; // where we store all colors that are not NO_COLOR
-    for(int i = 0; i < this->getNumColors(); i++) {
-        if(this->color_hist[i] == Color::WHITE) {
-            num_white += 1;
-            storage.push_back(Color::WHITE);
-        } else if(this->color_hist[i] == Color::BLACK) {
-            num_black += 1;
-            storage.push_back(Color::BLACK);
-        }
-    }
-    this->has_saved_color = true;
-    if(num_white == 0 && num_black == 0) {
+void CPPDubovSystem::Player::updateColorState() {
+    // due color first
+    if(this->num_white == 0 && this->num_black == 0) {
         this->due_color_saved = Color::NO_COLOR;
-        return Color::NO_COLOR;
-    }
-    if(num_white == num_black) {
-//        Color last_color = this->color_hist[this->getNumColors() - 1];
-        Color last_color = storage[((int) storage.size()) - 1];
-        if(last_color == Color::WHITE) {
-            this->due_color_saved = Color::BLACK;
-            return Color::BLACK;
-        }
-        this->due_color_saved = Color::WHITE;
-        return Color::WHITE;
-    } else if(num_white > num_black) {
+    } else if(this->num_white == this->num_black) {
+        // alternate from the last color played
+        this->due_color_saved = this->last_played == Color::WHITE ? Color::BLACK : Color::WHITE;
+    } else if(this->num_white > this->num_black) {
         this->due_color_saved = Color::BLACK;
-        return Color::BLACK;
-    }
-    this->due_color_saved = Color::WHITE;
-    return Color::WHITE;
-}
-
-CPPDubovSystem::ColorPreference CPPDubovSystem::Player::getPreferenceStrength() {
-    // check if this is already set
-    if(this->has_saved_strength) {
-        return this->strength;
+    } else {
+        this->due_color_saved = Color::WHITE;
     }
-    this->has_saved_strength = true;
+    
+    // now the strength
     // if there is only one color, preference is mild
-    std::vector<Color> storage;
     if(this->color_count == 1 && this->color_hist[0] != Color::NO_COLOR) {
         this->strength = ColorPreference::MILD;
-        return ColorPreference::MILD;
-    }
-    // same operation as getDueColor
-    int num_white = 0;
-    int num_black = 0;
-    for(int i = 0; i < this->getNumColors(); i++) {
-        if(this->color_hist[i] == Color::WHITE) {
-            num_white += 1;
-            storage.push_back(Color::WHITE);
-        } else if(this->color_hist[i] == Color::BLACK) {
-            num_black += 1;
-            storage.push_back(Color::BLACK);
-        }
-    }
-    if(num_white == 0 && num_black == 0) {
+    } else if(this->num_white == 0 && this->num_black == 0) {
         this->strength = ColorPreference::NO_PREFERENCE;
-        return ColorPreference::NO_PREFERENCE;
-    }
-    int storage_count = (int) storage.size();
-    // if the player played the same colors twice in a row, the preference is absolute
-    if(storage_count >= 2) {
-//        if(this->color_hist[this->color_count - 1] == this->color_hist[this->color_count - 2]) {
-//            this->strength = ColorPreference::ABSOLUTE;
-//            return ColorPreference::ABSOLUTE;
-//        }
-        if(storage[storage_count - 1] == storage[storage_count - 2]) {
-            this->strength = ColorPreference::ABSOLUTE;
-            return this->strength;
-        }
-    }
-    if(abs(num_white - num_black) == 1) {
+    } else if(this->num_white + this->num_black >= 2 && this->last_played == this->second_last_played) {
+        // if the player played the same colors twice in a row, the preference is absolute
+        this->strength = ColorPreference::ABSOLUTE;
+    } else if(abs(this->num_white - this->num_black) == 1) {
         this->strength = ColorPreference::MILD;
-        return ColorPreference::MILD;
-    }
-    if((num_white - num_black) == 0) {
+    } else if(this->num_white == this->num_black) {
         this->strength = ColorPreference::ALTERNATION;
-        return ColorPreference::ALTERNATION;
+    } else {
+        // should be at least +2
+        this->strength = ColorPreference::ABSOLUTE;
     }
-    // should be at least +2
-    this->strength = ColorPreference::ABSOLUTE;
-    return ColorPreference::ABSOLUTE;
 }
 
 void CPPDubovSystem::Player::addOpp(int id) {
-    this->opp_played.insert(id);
-    this->opp_played_return.push_back(id);
+    // keep the list sorted (players can meet the same opponent more than once, so duplicates are kept)
+    this->opp_played.insert(std::upper_bound(this->opp_played.begin(), this->opp_played.end(), id), id);
     this->opp_count += 1;
 }
 
 void CPPDubovSystem::Player::addColor(Color c) {
     this->color_count += 1;
     this->color_hist.push_back(c);
-    // mark saved preference and strength as unsaved
-    // the point of marking saved and unsaved is so that the value is only evaluated once
-    // this way, when getPreferenceStrength and getDueColor is executed, at the first time the time complexity is O(n) (where n is the number of colors passed in)
-    // after that call is done executing, it will save the values created from those function calls
-    // that way, the time complexity becomes O(1)
-    // and especially if this is needed to be executed multiple times (which will be the case), direct access to the saved variables will be given
-    this->has_saved_color = false;
-    this->has_saved_strength = false;
+    // keep the color counters up to date, so the due color and strength never have to look through the whole history
+    if(c == Color::WHITE) {
+        this->num_white += 1;
+    } else if(c == Color::BLACK) {
+        this->num_black += 1;
+    }
+    if(c != Color::NO_COLOR) {
+        this->second_last_played = this->last_played;
+        this->last_played = c;
+    }
+    this->updateColorState();
 }
 
 bool CPPDubovSystem::Player::canPlayOpp(Player &opp) {
     // check if both players have played each other before
 //    if(std::find(this->opp_played.begin(), this->opp_played.end(), opp.getID()) != this->opp_played.end()) {
-    if(this->opp_played.contains(opp.getID())) {
+    if(std::binary_search(this->opp_played.begin(), this->opp_played.end(), opp.getID())) {
         return false;
     }
     // make sure there isn't a pairing restriction set onto this opponent
-    if(this->pairing_restrictions.contains(opp.getID())) {
+    if(std::binary_search(this->pairing_restrictions.begin(), this->pairing_restrictions.end(), opp.getID())) {
         return false;
     }
     // check if the absolute color preference is present in both players and both players need that color
@@ -172,33 +136,22 @@ bool CPPDubovSystem::Player::canPlayOpp(Player &opp) {
     return true;
 }
 
-double CPPDubovSystem::Player::getARO() {
-    // check if aro was already created
-    if(this->aro > -1) {
-        return this->aro;
-    }
+double CPPDubovSystem::Player::getARO() const {
     // calculate average rating of opponents
     // if no opponents were played, aro is 0
-    if(this->opp_count == 0) {
-        this->aro = 0.0;
+    if(this->opp_rating_count == 0) {
         return 0.0;
     }
-    int tot = 0;
-    for(int i = 0; i < this->opp_count; i++) {
-        tot += this->opp_rating[i];
-    }
-    double tot_double = (double) tot;
-    double opp_double = (double) this->opp_count;
-    this->aro = (tot_double / opp_double);
+    double tot_double = (double) this->opp_rating_sum;
+    double opp_double = (double) this->opp_rating_count;
     // 1.6.1 -> round to the nearest integer
-    this->aro = std::round(this->aro);
-    return this->aro;
+    return std::round(tot_double / opp_double);
 }
 
 void CPPDubovSystem::Player::addOppRating(int r) {
-    this->opp_rating.push_back(r);
-    // and mark aro as not saved
-    this->aro = -1;
+    // only the sum and count are needed for the aro
+    this->opp_rating_sum += r;
+    this->opp_rating_count += 1;
 }
 
 void CPPDubovSystem::Player::incrementUpfloat() {
@@ -222,11 +175,15 @@ void CPPDubovSystem::Player::setUpfloatPrevStatus(bool s) {
 }
 
 void CPPDubovSystem::Player::addPoints(const double pt) {
-    this->points += pt;
+    this->half_points += (int) std::lround(pt * 2.0);
 }
 
 void CPPDubovSystem::Player::addPairingRestriction(int opp_id) {
-    this->pairing_restrictions.insert(opp_id);
+    auto it = std::lower_bound(this->pairing_restrictions.begin(), this->pairing_restrictions.end(), opp_id);
+    if(it != this->pairing_restrictions.end() && *it == opp_id) {
+        return; // already restricted
+    }
+    this->pairing_restrictions.insert(it, opp_id);
 }
 
 CPPDubovSystem::Color CPPDubovSystem::Player::getFirstColorPlayed() const {
@@ -305,8 +262,8 @@ bool CPPDubovSystem::Player::operator!=(const Player &other) {
 
 bool CPPDubovSystem::Player::operator<(const Player &other) {
     // we first compare the points
-    if(this->getPoints() > other.getPoints()) return false;
-    else if(this->getPoints() < other.getPoints()) return true;
+    if(this->getHalfPoints() > other.getHalfPoints()) return false;
+    else if(this->getHalfPoints() < other.getHalfPoints()) return true;
     
     // points are equal, so we look at the pairing number
     // it is known that pairing numbers are unique, so those simply cannot be equal
@@ -318,8 +275,8 @@ bool CPPDubovSystem::Player::operator<(const Player &other) {
 
 bool CPPDubovSystem::Player::operator>(const Player &other) {
     // we basically do the oppoisite of < operator
-    if(this->getPoints() > other.getPoints()) return true;
-    else if(this->getPoints() < other.getPoints()) return false;
+    if(this->getHalfPoints() > other.getHalfPoints()) return true;
+    else if(this->getHalfPoints() < other.getHalfPoints()) return false;
     
     if(this->getID() < other.getID()) return true;
     
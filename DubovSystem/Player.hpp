@@ -28,33 +28,52 @@
 
 #include <stdio.h>
 #include <string>
+#include <string_view>
+#include <memory>
+#include <unordered_map>
 #include <vector>
-#include <set>
 
 namespace CPPDubovSystem {
 
 /**
  * A simple color for a match
  */
-enum Color {
+enum Color : unsigned char {
     WHITE, BLACK, NO_COLOR
 };
 /**
  * Color preference for a match
  */
-enum ColorPreference {
+enum ColorPreference : unsigned char {
     NO_PREFERENCE = 1u, MILD, ALTERNATION, ABSOLUTE
 };
 
+/**
+ * Pool of player names, owned by a tournament. Every name is stored once and players with the same name share that copy.
+ * A name stays alive as long as the pool or any player holding it does, so players copied out of a tournament keep their names
+ */
+class NamePool {
+private:
+    /**
+     * All names interned so far, keyed by a view of the shared copy itself
+     */
+    std::unordered_map<std::string_view, std::shared_ptr<const std::string>> names;
+public:
+    /**
+     * Interns a name and gets the copy kept in the pool
+     */
+    std::shared_ptr<const std::string> intern(const std::string &name);
+};
+
 /**
  * Core player
  */
 class Player {
 private:
     /**
-     * Player name
+     * Player name (shared with the other players of the same name through the NamePool of the tournament)
      */
-    std::string name;
+    std::shared_ptr<const std::string> name;
     /**
      * Rating of player
      */
@@ -64,29 +83,33 @@ private:
      */
     int id;
     /**
-     * Number of points the player has
+     * Dense index of the player inside the tournament (assigned when the player is added to a tournament)
      */
-    double points;
+    int slot = -1;
     /**
-     * Opponents played to return
+     * Number of points the player has, counted in half points. Swiss scores are always a multiple of 0.5, so this is exact
      */
-    std::vector<int> opp_played_return;
+    int half_points;
     /**
-     * Storage for opponents played
+     * Ids of opponents played, kept sorted so membership is a binary search over one contiguous block
      */
-    std::set<int> opp_played;
+    std::vector<int> opp_played;
     /**
-     * List of pairing restrictions
+     * Ids of players this player may not be paired with (sorted, no duplicates)
      */
-    std::set<int> pairing_restrictions;
+    std::vector<int> pairing_restrictions;
     /**
      * History of colors played with
      */
     std::vector<Color> color_hist;
     /**
-     * Ratings of each opponent
+     * Sum of the ratings of each opponent
      */
-    std::vector<int> opp_rating;
+    int opp_rating_sum = 0;
+    /**
+     * Number of opponent ratings added to opp_rating_sum
+     */
+    int opp_rating_count = 0;
     /**
      * Number of opponents played
      */
@@ -100,45 +123,52 @@ private:
      */
     int numUpfloated = 0;
     /**
-     * For easy memory storage of aro when we need it
+     * Number of games played with white
      */
-    double aro = -1.0;
+    int num_white = 0;
     /**
-     * For players who upfloated in the last round
+     * Number of games played with black
      */
-    bool upfloated_prev = false;
+    int num_black = 0;
     /**
-     * If the player had a bye/forfeit win
+     * The last color actually played (NO_COLOR entries are skipped)
      */
-    bool received_bye = false;
+    Color last_played = Color::NO_COLOR;
+    /**
+     * The color actually played before the last one (NO_COLOR entries are skipped)
+     */
+    Color second_last_played = Color::NO_COLOR;
     /**
-     * The saved due color
+     * The current due color, kept up to date by addColor
      */
     Color due_color_saved = Color::NO_COLOR;
     /**
-     * Saved preference strength
+     * The current preference strength, kept up to date by addColor
      */
     ColorPreference strength = ColorPreference::NO_PREFERENCE;
     /**
-     * If color preference was saved
+     * For players who upfloated in the last round
      */
-    bool has_saved_color = false;
+    bool upfloated_prev = false;
     /**
-     * If strength has been saved
+     * If the player had a bye/forfeit win
      */
-    bool has_saved_strength = false;
-    
-public:
+    bool received_bye = false;
     
     /**
-     * For quick easy trf parsing
+     * Works out the due color and strength from the color counters
      */
-    double trf_pts = 0.0;
+    void updateColorState();
     
+public:
     /**
      * Initializes the player with a given name, rating, id, and points
      */
     explicit Player(std::string name, int rating, int id, double points);
+    /**
+     * Initializes the player with a given name, rating, id, and points, keeping the name in the given pool
+     */
+    explicit Player(const std::string &name, int rating, int id, double points, NamePool &names);
     /**
      * Default constructor for player
      */
@@ -147,7 +177,11 @@ public:
     /**
      * A getter for player name
      */
-    std::string getName() const {return name;}
+    std::string_view getName() const {return name ? std::string_view(*name) : std::string_view("UNNAMED PLAYER");}
+    /**
+     * Moves the name of the player into the given pool, so it is shared with the other players of the same name
+     */
+    void internName(NamePool &names) {if(name) name = names.intern(*name);}
     /**
      * A getter for rating
      */
@@ -156,6 +190,14 @@ public:
      * A getter for ID
      */
     int getID() const {return id;}
+    /**
+     * A getter for the tournament slot
+     */
+    int getSlot() const {return slot;}
+    /**
+     * Sets the tournament slot
+     */
+    void setSlot(int s) {slot = s;}
     /**
      * A getter for the number of colors played
      */
@@ -171,7 +213,11 @@ public:
     /**
      * A simple getter for points
      */
-    double getPoints() const {return points;}
+    double getPoints() const {return half_points / 2.0;}
+    /**
+     * Gets the points of the player counted in half points
+     */
+    int getHalfPoints() const {return half_points;}
     /**
      * Determines if the two players can play each other
      */
@@ -179,7 +225,7 @@ public:
     /**
      * Gets the average rating of opponents
      */
-    double getARO();
+    double getARO() const;
     /**
      * Adds an opponent to the list of played opponents
      */
@@ -191,11 +237,11 @@ public:
     /**
      * Gets the due color of the player
      */
-    Color getDueColor();
+    Color getDueColor() const {return due_color_saved;}
     /**
      * Gets the strength of the due color
      */
-    ColorPreference getPreferenceStrength();
+    ColorPreference getPreferenceStrength() const {return strength;}
     /**
      * Increments upfloat count
      */
@@ -207,9 +253,13 @@ public:
     /**
      * A getter for opponents played
      */
-    std::vector<int> getOppPlayed() const {return opp_played_return;}
+    const std::vector<int> &getOppPlayed() const {return opp_played;}
     /**
-     * Adds the opponents rating to the list of ratings
+     * A getter for the pairing restrictions
+     */
+    const std::vector<int> &getPairingRestrictions() const {return pairing_restrictions;}
+    /**
+     * Adds the opponents rating to the running sum of ratings
      */
     void addOppRating(int r);
     /**
@@ -224,6 +274,10 @@ public:
      * Adds points to the player
      */
     void addPoints(const double pt);
+    /**
+     * Adds a number of half points to the player
+     */
+    void addHalfPoints(int hp) {half_points += hp;}
     /**
      * Checks if the player has received a bye
      */
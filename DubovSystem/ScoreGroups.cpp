@@ -0,0 +1,55 @@
+//
+//  ScoreGroups.cpp
+//  DubovSystem
+//
+
+// Copyright 2024 Michael Shapiro
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ScoreGroups.hpp"
+
+CPPDubovSystem::ScoreGroups::ScoreGroups(): group_start(1, 0) {}
+
+CPPDubovSystem::ScoreGroups::ScoreGroups(std::vector<int> slots, std::vector<int> group_start, int slot_count): slots(std::move(slots)), group_start(std::move(group_start)), pulled(slot_count, false) {}
+
+std::vector<int> CPPDubovSystem::ScoreGroups::members(int g) const {
+    std::vector<int> m;
+    for(int i = this->begin(g); i < this->end(g); i++) {
+        if(this->pulled[this->slots[i]]) continue;
+        m.push_back(this->slots[i]);
+    }
+    return m;
+}
+
+void CPPDubovSystem::ScoreGroups::pull(int s) {
+    this->pulled[s] = true;
+    this->pull_log.push_back(s);
+}
+
+void CPPDubovSystem::ScoreGroups::undo(int mark) {
+    // put the players back in the reverse order they were pulled
+    while(((int) this->pull_log.size()) > mark) {
+        this->pulled[this->pull_log.back()] = false;
+        this->pull_log.pop_back();
+    }
+}
+
+CPPDubovSystem::ScoreGroups CPPDubovSystem::ScoreGroups::segment(int first, int last) const {
+    std::vector<int> seg_slots(this->slots.begin() + this->begin(first), this->slots.begin() + this->begin(last));
+    std::vector<int> seg_start;
+    for(int g = first; g <= last; g++) {
+        seg_start.push_back(this->begin(g) - this->begin(first));
+    }
+    return ScoreGroups(std::move(seg_slots), std::move(seg_start), (int) this->pulled.size());
+}
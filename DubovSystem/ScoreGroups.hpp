@@ -0,0 +1,103 @@
+//
+//  ScoreGroups.hpp
+//  DubovSystem
+//
+
+// Copyright 2024 Michael Shapiro
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ScoreGroups_hpp
+#define ScoreGroups_hpp
+
+#include <stdio.h>
+#include <vector>
+
+// the score groups are kept as ranges of one array of player slots, so the pairing engine never has to copy groups around
+namespace CPPDubovSystem {
+/**
+ * The score groups of a round. Each group is a range of one shared array of player slots.
+ * Players pulled up into a higher group (upfloaters) are only marked as pulled, and every pull can be undone when backtracking
+ */
+class ScoreGroups {
+private:
+    /**
+     * The player slots of all groups, one group after the other
+     */
+    std::vector<int> slots;
+    /**
+     * Where each group starts in slots. The last entry is the number of slots
+     */
+    std::vector<int> group_start;
+    /**
+     * If the player in a given slot has been pulled out of its group
+     */
+    std::vector<char> pulled;
+    /**
+     * All the slots pulled so far, in order. This is what makes undoing pulls possible
+     */
+    std::vector<int> pull_log;
+public:
+    /**
+     * Default constructor (no groups)
+     */
+    ScoreGroups();
+    /**
+     * Makes the groups from the slots of all groups and where each group starts. slot_count is one more than the highest slot
+     */
+    ScoreGroups(std::vector<int> slots, std::vector<int> group_start, int slot_count);
+
+    /**
+     * Gets the number of groups
+     */
+    int groupCount() const {return ((int) group_start.size()) - 1;}
+    /**
+     * Gets where the given group starts in the slot array
+     */
+    int begin(int g) const {return group_start[g];}
+    /**
+     * Gets where the given group ends in the slot array (one past the last player)
+     */
+    int end(int g) const {return group_start[g + 1];}
+    /**
+     * Gets the slot at a given position of the slot array
+     */
+    int at(int i) const {return slots[i];}
+    /**
+     * Checks if the player in the given slot has been pulled out of its group
+     */
+    bool isPulled(int s) const {return pulled[s];}
+    /**
+     * Gets the players still in the given group
+     */
+    std::vector<int> members(int g) const;
+    /**
+     * Pulls the player in the given slot out of its group
+     */
+    void pull(int s);
+    /**
+     * Gets a mark which can be used to undo all pulls done after this point
+     */
+    int mark() const {return (int) pull_log.size();}
+    /**
+     * Undoes all pulls done after the given mark
+     */
+    void undo(int mark);
+    /**
+     * Makes new groups out of the given range of groups (first up to but not including last), with nobody pulled
+     */
+    ScoreGroups segment(int first, int last) const;
+};
+}
+
+#endif /* ScoreGroups_hpp */
@@ -21,14 +21,21 @@
 
 #include "Tournament.hpp"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
 #include <cstdlib>
 #include <ctime>
+#include <exception>
 #include <queue>
 #include <random>
 #include <stack>
+#include <thread>
 #include "assertm.h"
 
-CPPDubovSystem::MatchEval::MatchEval(const Player &white, const Player &black, bool problem): Match(white, black, false) {
+CPPDubovSystem::SlotMatch::SlotMatch(int white, int black): white(white), black(black) {}
+
+CPPDubovSystem::MatchEval::MatchEval(int white, int black, bool problem): SlotMatch(white, black) {
     this->problem = problem;
 }
 
@@ -52,17 +59,19 @@ CPPDubovSystem::Utils::TRFMatch::TRFMatch() {
     this->target_round = -1;
 }
 
-void CPPDubovSystem::Utils::TRFMatch::distributePoints() {
-    this->white->trf_pts += this->white_pts;
-    this->black->trf_pts += this->black_pts;
+void CPPDubovSystem::Utils::TRFMatch::distributePoints(std::map<int, double> &trf_pts) const {
+    trf_pts[this->white->getID()] += this->white_pts;
+    trf_pts[this->black->getID()] += this->black_pts;
 }
 
-void CPPDubovSystem::Utils::TRFMatch::distributeFloat() {
+void CPPDubovSystem::Utils::TRFMatch::distributeFloat(std::map<int, double> &trf_pts) {
     if(this->black != nullptr) {
-        if(this->white->trf_pts > this->black->trf_pts) {
+        double w_pts = trf_pts[this->white->getID()];
+        double b_pts = trf_pts[this->black->getID()];
+        if(w_pts > b_pts) {
             this->black->incrementUpfloat();
             this->black->setUpfloatPrevStatus(true);
-        } else if(this->white->trf_pts < this->black->trf_pts) {
+        } else if(w_pts < b_pts) {
             this->white->incrementUpfloat();
             this->white->setUpfloatPrevStatus(true);
         } else {
@@ -87,139 +96,37 @@ int CPPDubovSystem::Utils::TRFMatch::getBID() const {
 }
 
 //MARK: SORTING ALGORITHMS TO USE FOR PAIRING
-/// Merge sort is the core sorting algorithm here (for all sorts)
+/// Utils::sortByKey is the core sorting algorithm here (for all sorts)
 
-void CPPDubovSystem::Tournament::mergeGroupARO(std::vector<Player> *group, const int left, const int mid, const int right) {
-    int const subVectorOne = mid - left + 1;
-    int const subVectorTwo = right - mid;
-    
-    auto *leftVector = new std::vector<Player>(), *rightVector = new std::vector<Player>();
-    leftVector->resize(subVectorOne);
-    rightVector->resize(subVectorTwo);
-    
-    for(auto i = 0; i < subVectorOne; i++) {
-        (*leftVector)[i] = (*group)[left + i];
-    }
-    for(auto i = 0; i < subVectorTwo; i++) {
-        (*rightVector)[i] = (*group)[mid + 1 + i];
-    }
-    
-    auto indexOfVectorOne = 0, indexOfVectorTwo = 0;
-    int indexOfMergedVector = left;
-    
-    while(indexOfVectorOne < subVectorOne && indexOfVectorTwo < subVectorTwo) {
-        // if aro is equal, get the lower pairing num of the two
-        if((*leftVector)[indexOfVectorOne].getARO() <= (*rightVector)[indexOfVectorTwo].getARO()) {
-            if((*leftVector)[indexOfVectorOne].getARO() == (*rightVector)[indexOfVectorTwo].getARO()) {
-//                if((*leftVector)[indexOfVectorOne].getRating() < (*rightVector)[indexOfVectorTwo].getRating()) {
-                if((*leftVector)[indexOfVectorOne].getID() < (*rightVector)[indexOfVectorTwo].getID()) {
-                    (*group)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-                    indexOfVectorOne += 1;
-                } else {
-                    (*group)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-                    indexOfVectorTwo += 1;
-                }
-            } else {
-                (*group)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-                indexOfVectorOne += 1;
-            }
-        } else {
-            (*group)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-            indexOfVectorTwo += 1;
-        }
-        indexOfMergedVector += 1;
-    }
-    
-    while(indexOfVectorOne < subVectorOne) {
-        (*group)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-        indexOfVectorOne += 1;
-        indexOfMergedVector += 1;
-    }
-    
-    while(indexOfVectorTwo < subVectorTwo) {
-        (*group)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-        indexOfVectorTwo += 1;
-        indexOfMergedVector += 1;
-    }
-    
-    delete leftVector;
-    delete rightVector;
+void CPPDubovSystem::Tournament::sortGroupARO(std::vector<int> *group, const int begin, const int end) {
+    // lower aro goes first, and if aro is equal, get the lower pairing num of the two
+    // aro is always rounded to an integer (1.6.1), so it fits in the upper half of the key
+    Utils::sortByKey(group, begin, end, [this](int s) {
+        return (((std::uint64_t) Utils::orderedKey((int) this->table->aro[s])) << 32) | Utils::orderedKey(this->table->id[s]);
+    });
 }
 
-void CPPDubovSystem::Utils::mergeRawMatches(std::vector<Utils::TRFMatch> *raw_games, const int left, const int mid, const int right) {
-    int const subVectorOne = mid - left + 1;
-    int const subVectorTwo = right - mid;
-    
-    auto *leftVector = new std::vector<Utils::TRFMatch>(), *rightVector = new std::vector<Utils::TRFMatch>();
-    leftVector->resize(subVectorOne);
-    rightVector->resize(subVectorTwo);
-    
-    for(auto i = 0; i < subVectorOne; i++) {
-        (*leftVector)[i] = (*raw_games)[left + i];
-    }
-    for(auto i = 0; i < subVectorTwo; i++) {
-        (*rightVector)[i] = (*raw_games)[mid + 1 + i];
-    }
-    
-    auto indexOfVectorOne = 0, indexOfVectorTwo = 0;
-    int indexOfMergedVector = left;
-    
-    while(indexOfVectorOne < subVectorOne && indexOfVectorTwo < subVectorTwo) {
-        if((*leftVector)[indexOfVectorOne].getTargetRound() <= (*rightVector)[indexOfVectorTwo].getTargetRound()) {
-            (*raw_games)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-            indexOfVectorOne += 1;
-        } else {
-            (*raw_games)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-            indexOfVectorTwo += 1;
-        }
-        indexOfMergedVector += 1;
-    }
-    
-    while(indexOfVectorOne < subVectorOne) {
-        (*raw_games)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-        indexOfVectorOne += 1;
-        indexOfMergedVector += 1;
-    }
-    
-    while(indexOfVectorTwo < subVectorTwo) {
-        (*raw_games)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-        indexOfVectorTwo += 1;
-        indexOfMergedVector += 1;
-    }
-    
-    delete leftVector;
-    delete rightVector;
-}
-
-void CPPDubovSystem::Tournament::sortGroupARO(std::vector<Player> *group, const int begin, const int end) {
-    if(begin >= end) {
-        return;
-    }
-    
-    int mid = begin + (end - begin) / 2;
-    this->sortGroupARO(group, begin, mid);
-    this->sortGroupARO(group, mid + 1, end);
-    this->mergeGroupARO(group, begin, mid, end);
+void CPPDubovSystem::Utils::sortRawMatches(std::vector<Utils::TRFMatch> *raw_games, const int begin, const int end) {
+    // earlier rounds go first
+    Utils::sortByKey(raw_games, begin, end, [](const Utils::TRFMatch &m) {
+        return (std::uint64_t) m.getTargetRound();
+    });
 }
 
-void CPPDubovSystem::Utils::sortRawMatches(std::vector<Utils::TRFMatch> *raw_games, const int begin, const int end) {
-    if(begin >= end) {
-        return;
-    }
-    
-    int mid = begin + (end - begin) / 2;
-    Utils::sortRawMatches(raw_games, begin, mid);
-    Utils::sortRawMatches(raw_games, mid + 1, end);
-    Utils::mergeRawMatches(raw_games, begin, mid, end);
+void CPPDubovSystem::Tournament::sortGroupRating(std::vector<int> *group) const {
+    // the rating order is really just the pairing number order
+    Utils::sortByKey(group, 0, ((int) group->size()) - 1, [this](int s) {
+        return (std::uint64_t) Utils::orderedKey(this->table->id[s]);
+    });
 }
 
-//MARK: MERGE SORT IMPLEMENTATION END
+//MARK: SORTING ALGORITHMS END
 
-void CPPDubovSystem::Tournament::splitGroups(std::vector<Player> *white_seekers, std::vector<Player> *black_seekers, std::vector<Player> &group) {
+void CPPDubovSystem::Tournament::splitGroups(std::vector<int> *white_seekers, std::vector<int> *black_seekers, const std::vector<int> &group) {
     // put all white seekers into the white seekers container
     // likewise all black seekers should go into the black seekers container
     for(int i = 0; i < group.size(); i++) {
-        if(group[i].getDueColor() == Color::WHITE) {
+        if(this->table->due_color[group[i]] == Color::WHITE) {
             white_seekers->push_back(group[i]);
         } else {
             black_seekers->push_back(group[i]);
@@ -227,14 +134,14 @@ void CPPDubovSystem::Tournament::splitGroups(std::vector<Player> *white_seekers,
     }
 }
 
-void CPPDubovSystem::Tournament::mergeMatches(const std::vector<Match> &m1, std::vector<Match> *main) {
+void CPPDubovSystem::Tournament::mergeMatches(const std::vector<SlotMatch> &m1, std::vector<SlotMatch> *main) {
     // merge both vectors into main
     for(int i = 0; i < m1.size(); i++) {
         main->push_back(m1[i]);
     }
 }
 
-void CPPDubovSystem::Tournament::mergeUpfloaterWrappers(const std::vector<Player> &wrong_colors, const std::vector<Player> &max_upfloat, std::vector<Player> *upfloaters) {
+void CPPDubovSystem::Tournament::mergeUpfloaterWrappers(const std::vector<int> &wrong_colors, const std::vector<int> &max_upfloat, std::vector<int> *upfloaters) {
     // simply combine all the different sets of upfloaters into one bin of upfloaters
     for(int i = 0; i < wrong_colors.size(); i++) {
         upfloaters->push_back(wrong_colors[i]);
@@ -245,50 +152,49 @@ void CPPDubovSystem::Tournament::mergeUpfloaterWrappers(const std::vector<Player
     }
 }
 
-std::vector<CPPDubovSystem::Player> CPPDubovSystem::Tournament::findUpfloaters(LinkedListNode &next_group, int imbalance) {
-    std::vector<Player> upfloaters;
+std::vector<int> CPPDubovSystem::Tournament::findUpfloaters(int next_group, int imbalance) {
+    std::vector<int> upfloaters;
     
     // look through sorted partition and evaluate with given score
-    LinkedListNode* curr = &next_group;
-    while(curr != nullptr) {
-        std::vector<Player> upfloater_max;
-        std::vector<Player> wrong_color; // C.7 minimize players who don't get their color preference
-        std::vector<Player> upfloated_previous; // C.10 minimize upfloaters who upfloated previously
-        for(int i = 0; i < curr->data.size(); i++) {
+    for(int g = next_group; g < this->groups.groupCount(); g++) {
+        std::vector<int> upfloater_max;
+        std::vector<int> wrong_color; // C.7 minimize players who don't get their color preference
+        std::vector<int> upfloated_previous; // C.10 minimize upfloaters who upfloated previously
+        for(int i = this->groups.begin(g); i < this->groups.end(g); i++) {
+            int p = this->groups.at(i);
+            // skip anyone who was already pulled up into a higher group
+            if(this->groups.isPulled(p)) continue;
             // make sure this player is not marked as an upfloater already
             // we can ignore all the float history if it is the last round
-            if(!curr->data[i].canUpfloat(this->total_rounds) && this->current_round != this->total_rounds) {
-                upfloater_max.push_back(curr->data[i]);
+            if(!this->table->canUpfloat(p, this->total_rounds) && this->current_round != this->total_rounds) {
+                upfloater_max.push_back(p);
                 continue;
             }
             // C.10 minimize upfloaters who upfloated previously
-            if(curr->data[i].upfloatedPreviously() && this->current_round != this->total_rounds) {
-                upfloated_previous.push_back(curr->data[i]);
+            if(this->table->upfloated_prev[p] && this->current_round != this->total_rounds) {
+                upfloated_previous.push_back(p);
                 continue;
             }
 //            if(imbalance == 1) {
             if(imbalance > 0) {
-                if(curr->data[i].getDueColor() == Color::WHITE) {
-                    wrong_color.push_back(curr->data[i]);
+                if(this->table->due_color[p] == Color::WHITE) {
+                    wrong_color.push_back(p);
                     continue;
                 }
-                upfloaters.push_back(curr->data[i]);
+                upfloaters.push_back(p);
             } else {
-                if(curr->data[i].getDueColor() == Color::BLACK || curr->data[i].getDueColor() == Color::NO_COLOR) {
-                    wrong_color.push_back(curr->data[i]);
+                if(this->table->due_color[p] == Color::BLACK || this->table->due_color[p] == Color::NO_COLOR) {
+                    wrong_color.push_back(p);
                     continue;
                 }
-                upfloaters.push_back(curr->data[i]);
+                upfloaters.push_back(p);
             }
         }
         
         // merge wrong color and max upfloaters with upfloaters
         this->mergeUpfloaterWrappers(wrong_color, upfloater_max, &upfloaters);
         // also merge float prev
-        this->mergeUpfloaterWrappers(upfloated_previous, std::vector<Player>(), &upfloaters);
-        
-        // shift node
-        curr = curr->next;
+        this->mergeUpfloaterWrappers(upfloated_previous, std::vector<int>(), &upfloaters);
         
         // C.6 minimize score difference
     }
@@ -296,25 +202,89 @@ std::vector<CPPDubovSystem::Player> CPPDubovSystem::Tournament::findUpfloaters(L
     return upfloaters;
 }
 
-void CPPDubovSystem::Tournament::getExchangeShifters(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, std::vector<int> &w_shift, std::vector<int> &b_shift, bool &error) {
+std::pair<std::vector<int>, int> CPPDubovSystem::Tournament::solveMatching(const Graph &g, const std::vector<int> &cost, const std::pmr::vector<int> *vertex_slots, int *deficiency) {
+    // only warm start if we know who the vertices are
+    bool warm = vertex_slots != nullptr && !this->warm_mate.empty();
+    std::pair<std::vector<int>, int> matched;
+    std::vector<int> maximum;
+    
+    // when only white seekers and black seekers can meet, the graph is bipartite and there are no blossoms to worry about
+    std::vector<int> side;
+    if(BipartiteMatching<int>::IsBipartite(g, side)) {
+        // hopcroft-karp tells us quickly if there is no perfect matching at all, so only run the hungarian solve if there is one
+        maximum = BipartiteMatching<int>::SolveMaximumMatching(g, side);
+        if(((int) maximum.size()) * 2 == g.GetNumVertices()) {
+            BipartiteMatching<int> bm(g, side);
+            matched = bm.SolveMinimumCostPerfectMatching(cost);
+            maximum = matched.first;
+        } else {
+            matched = std::make_pair(std::vector<int>(), -1);
+        }
+    } else {
+        Matching<int> matching(g);
+        if(warm) {
+            // retries of the same bracket only differ by a player or two, so start from how these players were matched last time
+            std::vector<std::pair<int, int>> seed;
+            for(int v = 0; v < vertex_slots->size(); v++) {
+                this->warm_vertex[(*vertex_slots)[v]] = v;
+            }
+            for(int v = 0; v < vertex_slots->size(); v++) {
+                int m = this->warm_mate[(*vertex_slots)[v]];
+                if(m == -1 || this->warm_vertex[m] == -1) continue;
+                seed.push_back(std::make_pair(v, this->warm_vertex[m]));
+            }
+            for(int v = 0; v < vertex_slots->size(); v++) {
+                this->warm_vertex[(*vertex_slots)[v]] = -1;
+            }
+            matching.WarmStart(seed);
+        }
+        // the blossom solver already looks for a maximum cardinality matching first, and gives up before the weighted part if it is not perfect
+        matched = matching.SolveMinimumCostPerfectMatching(cost);
+        maximum = matched.first.empty() ? matching.GetMaximumMatching() : matched.first;
+    }
+    
+    if(deficiency != nullptr) {
+        *deficiency = g.GetNumVertices() - ((int) maximum.size()) * 2;
+    }
+    
+    if(warm) {
+        // remember how everyone got matched for next time
+        for(int v = 0; v < vertex_slots->size(); v++) {
+            this->warm_mate[(*vertex_slots)[v]] = -1;
+        }
+        for(auto e : maximum) {
+            std::pair<int, int> ends;
+            // the warm start is only a hint, so an edge that can't be looked up is simply left out
+            if(g.TryGetEdge(e, ends) != GRAPH_OK) continue;
+            int s1 = (*vertex_slots)[ends.first];
+            int s2 = (*vertex_slots)[ends.second];
+            this->warm_mate[s1] = s2;
+            this->warm_mate[s2] = s1;
+        }
+    }
+    
+    return matched;
+}
+
+void CPPDubovSystem::Tournament::getExchangeShifters(std::vector<int> &white_seekers, std::vector<int> &black_seekers, std::vector<int> &w_shift, std::vector<int> &b_shift, bool &error) {
     // first generate a migration queue for both sides
     std::vector<int> w_migration = this->generateMigrationQueue(white_seekers);
     std::vector<int> b_migration = this->generateMigrationQueue(black_seekers);
     
     // quickly add vertecies to our graph
     Graph g_main(((int) white_seekers.size()) + ((int) black_seekers.size()));
-    std::map<int, int> p_map;
-    std::vector<Player> p_equiv(((int) white_seekers.size()) + ((int) black_seekers.size()));
-    std::vector<std::pair<int, int>> move_priority(p_equiv.size()); // first is priority, second is index
+    std::pmr::map<int, int> p_map(this->scratch);
+    std::pmr::vector<int> p_equiv(((int) white_seekers.size()) + ((int) black_seekers.size()), this->scratch);
+    std::pmr::vector<std::pair<int, int>> move_priority(p_equiv.size(), this->scratch); // first is priority, second is index
     int vertex_id = 0;
     for(int i = 0; i < white_seekers.size(); i++) {
-        p_map[white_seekers[i].getID()] = vertex_id;
+        p_map[white_seekers[i]] = vertex_id;
         p_equiv[vertex_id] = white_seekers[i];
         move_priority[vertex_id] = std::make_pair(0, i);
         vertex_id += 1;
     }
     for(int i = 0; i < black_seekers.size(); i++) {
-        p_map[black_seekers[i].getID()] = vertex_id;
+        p_map[black_seekers[i]] = vertex_id;
         p_equiv[vertex_id] = black_seekers[i];
         move_priority[vertex_id] = std::make_pair(0, i);
         vertex_id += 1;
@@ -323,12 +293,12 @@ void CPPDubovSystem::Tournament::getExchangeShifters(std::vector<Player> &white_
     // now to initialize weights
     // we are only using minimum weight matching to determine who to move
     // so weights shouldn't matter too much when pairing players of opposite colors
-    std::vector<double> cost;
+    std::vector<int> cost;
     for(int i = 0; i < white_seekers.size(); i++) {
         for(int z = 0; z < black_seekers.size(); z++) {
             // make sure players are compatible
-            if(white_seekers[i].canPlayOpp(black_seekers[z])) {
-                g_main.AddEdge(p_map[white_seekers[i].getID()], p_map[black_seekers[z].getID()]);
+            if(this->canPlay(white_seekers[i], black_seekers[z])) {
+                g_main.AddEdge(p_map[white_seekers[i]], p_map[black_seekers[z]]);
                 cost.push_back(0); // again, we are only using the graph for optimal selection, so the weight doesn't matter, it just has to be lower then everything else
             }
         }
@@ -341,7 +311,7 @@ void CPPDubovSystem::Tournament::getExchangeShifters(std::vector<Player> &white_
     for(int i = 0; i < w_migration.size(); i++) {
         // pair against group
         int index_check = w_migration[i];
-        move_priority[p_map[white_seekers[index_check].getID()]].first = min_weight;
+        move_priority[p_map[white_seekers[index_check]]].first = min_weight;
         for(int z = 0; z < white_seekers.size(); z++) {
             // make sure index_check is not z
             if(index_check == z) continue;
@@ -350,8 +320,8 @@ void CPPDubovSystem::Tournament::getExchangeShifters(std::vector<Player> &white_
             if(migration_w_done[z]) continue;
             
             // now compare
-            if(white_seekers[index_check].canPlayOpp(white_seekers[z])) {
-                g_main.AddEdge(p_map[white_seekers[index_check].getID()], p_map[white_seekers[z].getID()]);
+            if(this->canPlay(white_seekers[index_check], white_seekers[z])) {
+                g_main.AddEdge(p_map[white_seekers[index_check]], p_map[white_seekers[z]]);
                 cost.push_back(min_weight);
             }
         }
@@ -369,7 +339,7 @@ void CPPDubovSystem::Tournament::getExchangeShifters(std::vector<Player> &white_
     for(int i = 0; i < b_migration.size(); i++) {
         // pair against group
         int index_check = b_migration[i];
-        move_priority[p_map[black_seekers[index_check].getID()]].first = min_weight;
+        move_priority[p_map[black_seekers[index_check]]].first = min_weight;
         for(int z = 0; z < black_seekers.size(); z++) {
             // make sure index_check is not z
             if(index_check == z) continue;
@@ -378,8 +348,8 @@ void CPPDubovSystem::Tournament::getExchangeShifters(std::vector<Player> &white_
             if(migration_w_done[z]) continue;
             
             // now compare
-            if(black_seekers[index_check].canPlayOpp(black_seekers[z])) {
-                g_main.AddEdge(p_map[black_seekers[index_check].getID()], p_map[black_seekers[z].getID()]);
+            if(this->canPlay(black_seekers[index_check], black_seekers[z])) {
+                g_main.AddEdge(p_map[black_seekers[index_check]], p_map[black_seekers[z]]);
                 cost.push_back(min_weight);
             }
         }
@@ -390,22 +360,27 @@ void CPPDubovSystem::Tournament::getExchangeShifters(std::vector<Player> &white_
         min_weight += 1;
     }
     
-    // now set up the matching
-    Matching matching(g_main);
-    
-    // compute matching
-    std::pair<std::list<int>, double> matched = matching.SolveMinimumCostPerfectMatching(cost);
+    // now compute the matching
+    int deficiency = 0;
+    std::pair<std::vector<int>, int> matched = this->solveMatching(g_main, cost, &p_equiv, &deficiency);
     
     // make sure matching exists
-    if(matched.first.size() == 0) {
+    if(deficiency > 0) {
         error = true;
         return;
     }
     
-    for(std::list<int>::iterator it = matched.first.begin(); it != matched.first.end(); it++) {
-        std::pair<int, int> e = g_main.GetEdge(*it);
-        Color e1_col = p_equiv[e.first].getDueColor();
-        Color e2_col = p_equiv[e.second].getDueColor();
+    for(std::vector<int>::iterator it = matched.first.begin(); it != matched.first.end(); it++) {
+        std::pair<int, int> e;
+        if(g_main.TryGetEdge(*it, e) != GRAPH_OK) {
+            // the matching gave an edge that is not in the graph, so none of the shifters can be trusted
+            w_shift.clear();
+            b_shift.clear();
+            error = true;
+            return;
+        }
+        Color e1_col = this->table->due_color[p_equiv[e.first]];
+        Color e2_col = this->table->due_color[p_equiv[e.second]];
         
         // we have a shifter if both players of the same due color end up playing each other
         if(e1_col == e2_col) {
@@ -530,38 +505,38 @@ void CPPDubovSystem::Tournament::getExchangeShifters(std::vector<Player> &white_
     *b_shift = b_shifters;
 }*/
 
-void CPPDubovSystem::Tournament::applyStandardShifters(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, bool &error) {
+void CPPDubovSystem::Tournament::applyStandardShifters(std::vector<int> &white_seekers, std::vector<int> &black_seekers, bool &error) {
     
     // the process here should be similar to getExchangeShifters
     // just the weights need to be set up slightly differently
     // we first need to initilaize our graph
     Graph g_main(((int) white_seekers.size()) + ((int) black_seekers.size()));
     
-    std::map<int, int> p_map;
-    std::vector<Player> p_equiv(((int) white_seekers.size()) + ((int) black_seekers.size()));
-    std::vector<std::pair<int, int>> move_priority(p_equiv.size()); // first is priority, second is index
+    std::pmr::map<int, int> p_map(this->scratch);
+    std::pmr::vector<int> p_equiv(((int) white_seekers.size()) + ((int) black_seekers.size()), this->scratch);
+    std::pmr::vector<std::pair<int, int>> move_priority(p_equiv.size(), this->scratch); // first is priority, second is index
     int vertex_id = 0;
     for(int i = 0; i < white_seekers.size(); i++) {
-        p_map[white_seekers[i].getID()] = vertex_id;
+        p_map[white_seekers[i]] = vertex_id;
         p_equiv[vertex_id] = white_seekers[i];
         move_priority[vertex_id] = std::make_pair(0, i);
         vertex_id += 1;
     }
     for(int i = 0; i < black_seekers.size(); i++) {
-        p_map[black_seekers[i].getID()] = vertex_id;
+        p_map[black_seekers[i]] = vertex_id;
         p_equiv[vertex_id] = black_seekers[i];
         move_priority[vertex_id] = std::make_pair(0, i);
         vertex_id += 1;
     }
     
-    std::vector<double> cost;
+    std::vector<int> cost;
     
     // first set all pairing of opposite due color to 0 weight
     for(int i = 0; i < white_seekers.size(); i++) {
         for(int z = 0; z < black_seekers.size(); z++) {
             // make sure players are compatible
-            if(white_seekers[i].canPlayOpp(black_seekers[z])) {
-                g_main.AddEdge(p_map[white_seekers[i].getID()], p_map[black_seekers[z].getID()]);
+            if(this->canPlay(white_seekers[i], black_seekers[z])) {
+                g_main.AddEdge(p_map[white_seekers[i]], p_map[black_seekers[z]]);
                 cost.push_back(0); // again, we are only using the graph for optimal selection, so the weight doesn't matter, it just has to be lower then everything else
             }
         }
@@ -570,8 +545,8 @@ void CPPDubovSystem::Tournament::applyStandardShifters(std::vector<Player> &whit
     // now for determining weights on the group itself
     // the larger group should have the smaller weights
     int min_weight = 1;
-    std::vector<Player> &larger_group = white_seekers.size() > black_seekers.size() ? white_seekers : black_seekers;
-    std::vector<Player> &smaller_group = white_seekers.size() < black_seekers.size() ? white_seekers : black_seekers;
+    std::vector<int> &larger_group = white_seekers.size() > black_seekers.size() ? white_seekers : black_seekers;
+    std::vector<int> &smaller_group = white_seekers.size() < black_seekers.size() ? white_seekers : black_seekers;
     std::vector<int> larger_migration = this->generateMigrationQueue(white_seekers.size() > black_seekers.size() ? white_seekers : black_seekers);
     std::vector<int> smaller_migration = this->generateMigrationQueue(white_seekers.size() < black_seekers.size() ? white_seekers : black_seekers);
     std::vector<bool> migration_w_done(std::max(white_seekers.size(), black_seekers.size()));
@@ -582,7 +557,7 @@ void CPPDubovSystem::Tournament::applyStandardShifters(std::vector<Player> &whit
     for(int i = 0; i < larger_group.size(); i++) {
         // pair against group
         int index_check = larger_migration[i];
-        move_priority[p_map[larger_group[index_check].getID()]].first = min_weight;
+        move_priority[p_map[larger_group[index_check]]].first = min_weight;
         for(int z = 0; z < larger_group.size(); z++) {
             // make sure index_check is not z
             if(index_check == z) continue;
@@ -591,8 +566,8 @@ void CPPDubovSystem::Tournament::applyStandardShifters(std::vector<Player> &whit
             if(migration_w_done[z]) continue;
             
             // now compare
-            if(larger_group[index_check].canPlayOpp(larger_group[z])) {
-                g_main.AddEdge(p_map[larger_group[index_check].getID()], p_map[larger_group[z].getID()]);
+            if(this->canPlay(larger_group[index_check], larger_group[z])) {
+                g_main.AddEdge(p_map[larger_group[index_check]], p_map[larger_group[z]]);
                 cost.push_back(min_weight);
             }
         }
@@ -608,7 +583,7 @@ void CPPDubovSystem::Tournament::applyStandardShifters(std::vector<Player> &whit
     for(int i = 0; i < smaller_group.size(); i++) {
         // pair against group
         int index_check = smaller_migration[i];
-        move_priority[p_map[smaller_group[index_check].getID()]].first = min_weight;
+        move_priority[p_map[smaller_group[index_check]]].first = min_weight;
         for(int z = 0; z < smaller_group.size(); z++) {
             // make sure index_check is not z
             if(index_check == z) continue;
@@ -617,8 +592,8 @@ void CPPDubovSystem::Tournament::applyStandardShifters(std::vector<Player> &whit
             if(migration_w_done[z]) continue;
             
             // now compare
-            if(smaller_group[index_check].canPlayOpp(smaller_group[z])) {
-                g_main.AddEdge(p_map[smaller_group[index_check].getID()], p_map[smaller_group[z].getID()]);
+            if(this->canPlay(smaller_group[index_check], smaller_group[z])) {
+                g_main.AddEdge(p_map[smaller_group[index_check]], p_map[smaller_group[z]]);
                 cost.push_back(min_weight);
             }
         }
@@ -630,27 +605,31 @@ void CPPDubovSystem::Tournament::applyStandardShifters(std::vector<Player> &whit
     }
     
     // finally we can do the actual matching
-    Matching matching(g_main);
-    
-    std::pair<std::list<int>, double> matched = matching.SolveMinimumCostPerfectMatching(cost);
+    int deficiency = 0;
+    std::pair<std::vector<int>, int> matched = this->solveMatching(g_main, cost, &p_equiv, &deficiency);
     
     // make sure matching exists
-    if(matched.first.size() == 0) {
+    if(deficiency > 0) {
         error = true;
         return;
     }
     
-    std::vector<Player> reconstructed_black_seekers;
-    std::vector<Player> reconstructed_white_seekers;
+    std::vector<int> reconstructed_black_seekers;
+    std::vector<int> reconstructed_white_seekers;
     
-    std::set<int> w_remove;
-    std::set<int> b_remove;
+    std::pmr::set<int> w_remove(this->scratch);
+    std::pmr::set<int> b_remove(this->scratch);
     
     // else find the players who we move, and do the move
-    for(std::list<int>::iterator it = matched.first.begin(); it != matched.first.end(); it++) {
-        std::pair<int, int> e = g_main.GetEdge(*it);
-        Color e1_col = p_equiv[e.first].getDueColor();
-        Color e2_col = p_equiv[e.second].getDueColor();
+    for(std::vector<int>::iterator it = matched.first.begin(); it != matched.first.end(); it++) {
+        std::pair<int, int> e;
+        if(g_main.TryGetEdge(*it, e) != GRAPH_OK) {
+            // the matching gave an edge that is not in the graph, so nothing is moved
+            error = true;
+            return;
+        }
+        Color e1_col = this->table->due_color[p_equiv[e.first]];
+        Color e2_col = this->table->due_color[p_equiv[e.second]];
         
         // we have a shifter if both players of the same due color end up playing each other
         if(e1_col == e2_col || (e1_col == Color::BLACK && e2_col == Color::NO_COLOR) || (e1_col == Color::NO_COLOR && e2_col == Color::BLACK)) {
@@ -696,87 +675,108 @@ void CPPDubovSystem::Tournament::applyStandardShifters(std::vector<Player> &whit
     
     // now resort the groups
     this->sortGroupARO(&white_seekers, 0, ((int) white_seekers.size()) - 1);
-    Utils::sortPlayersRating(&black_seekers, 0, ((int) black_seekers.size()) - 1);
+    this->sortGroupRating(&black_seekers);
 }
 
-std::shared_ptr<CPPDubovSystem::Tournament::eval_games> CPPDubovSystem::Tournament::nextTransposition(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, int pof) {
-    // get pivot point
-    Player pivot = black_seekers[pof];
-    // impose temporary pairing restriction to avoid infinite loops
-//    white_seekers[pof].addPairingRestriction(pivot.getID());
-    // construct black seekers up until pivot
-    std::vector<Player> black_seekers_new;
-    for(int i = 0; i < pof; i++) {
-        black_seekers_new.push_back(black_seekers[i]);
-    }
-    
-    // make sorted set of pivot point included
-    std::vector<Player> pivot_include;
-    for(int i = pof; i < black_seekers.size(); i++) {
-        pivot_include.push_back(black_seekers[i]);
-    }
-    
-    // make sure pivot_include is sorted properly
-    Utils::sortPlayersRating(&pivot_include, 0, ((int) pivot_include.size()) - 1);
-    bool touched_pivot = false;
-    // pick first element in pivot_include which white seeker at element pof can player
-    int works = -1;
-    for(int i = 0; i < pivot_include.size(); i++) {
-        if(!touched_pivot) {
-            if(pivot_include[i].getID() == pivot.getID()) {
-                touched_pivot = true;
+template<class Mask>
+std::shared_ptr<CPPDubovSystem::Tournament::eval_games> CPPDubovSystem::Tournament::nextTransposition(std::vector<int> &white_seekers, std::vector<int> &black_seekers, int pof) {
+    int boards = (int) white_seekers.size();
+    // the search works on the rank of each black seeker in the rating order, so the players are never copied or re-sorted
+    std::vector<int> by_rating(black_seekers);
+    this->sortGroupRating(&by_rating);
+    std::vector<int> order(boards);
+    for(int i = 0; i < boards; i++) {
+        order[i] = (int) (std::lower_bound(by_rating.begin(), by_rating.end(), black_seekers[i], [this](int a, int b) {
+            return this->table->id[a] < this->table->id[b];
+        }) - by_rating.begin());
+    }
+    
+    // a mask has a bit for every black seeker (by rank), in 64 bit words
+    // small brackets use a fixed size mask, and a vector is only sized up for the bigger ones
+    Mask blank{};
+    if constexpr (requires { blank.resize(0); }) {
+        blank.resize((boards + 63) / 64);
+    }
+    int words = (int) blank.size();
+    
+    // one mask for every board, with a bit set for every black seeker the white seeker can play
+    std::vector<Mask> compatible(boards, blank);
+    for(int i = 0; i < boards; i++) {
+        for(int r = 0; r < boards; r++) {
+            if(this->canPlay(white_seekers[i], by_rating[r])) {
+                compatible[i][r >> 6] |= ((std::uint64_t) 1) << (r & 63);
             }
-            continue;
-        }
-        if(white_seekers[pof].canPlayOpp(pivot_include[i]) && pivot_include[i].getID() != pivot.getID()) {
-            // works
-            works = i;
-            break;
         }
     }
+    auto fits = [&](int board) {
+        return (compatible[board][order[board] >> 6] >> (order[board] & 63)) & 1u;
+    };
     
-    // check if we found a useful player
-    if(works == -1) {
-        if(pof == 0) {
-            // no more useful transpositions
-            return nullptr;
+    Mask rest(blank);
+    while(true) {
+        // get pivot point, and everybody from the pivot down
+        int pivot = order[pof];
+        std::fill(rest.begin(), rest.end(), 0);
+        for(int i = pof; i < boards; i++) {
+            rest[order[i] >> 6] |= ((std::uint64_t) 1) << (order[i] & 63);
         }
-        // continue to search for a useful transposition
-        return this->nextTransposition(white_seekers, black_seekers, pof - 1);
-    }
-    
-    // try pairing and check for any other pairing errors
-    // this can be accomplished by recreating the black seekers
-    black_seekers_new.push_back(pivot_include[works]);
-    // add all elements in pivot
-    for(int i = 0; i < pivot_include.size(); i++) {
-        if(i == works) {
+        
+        // pick the first player rated below the pivot which the white seeker at pof can play
+        int works = -1;
+        for(int w = pivot >> 6; w < words; w++) {
+            std::uint64_t usable = rest[w] & compatible[pof][w];
+            if(w == (pivot >> 6)) {
+                // only the players after the pivot
+                usable &= ~((((std::uint64_t) 2) << (pivot & 63)) - 1);
+            }
+            if(usable != 0) {
+                works = w * 64 + std::countr_zero(usable);
+                break;
+            }
+        }
+        
+        // check if we found a useful player
+        if(works == -1) {
+            if(pof == 0) {
+                // no more useful transpositions
+                return nullptr;
+            }
+            // continue to search for a useful transposition
+            pof -= 1;
             continue;
         }
-        black_seekers_new.push_back(pivot_include[i]);
-    }
-    // try pairing bracket
-    int first_problem = -1;
-    eval_games transposition_eval;
-    for(int i = 0; i < white_seekers.size(); i++) {
-        if(!white_seekers[i].canPlayOpp(black_seekers_new[i])) {
-            if(first_problem == -1) {
+        
+        // put the player on this board, and everybody else from the pivot down after it in rating order
+        order[pof] = works;
+        rest[works >> 6] &= ~(((std::uint64_t) 1) << (works & 63));
+        int next = pof + 1;
+        for(int w = 0; w < words; w++) {
+            for(std::uint64_t left = rest[w]; left != 0; left &= left - 1) {
+                order[next++] = w * 64 + std::countr_zero(left);
+            }
+        }
+        
+        // check for any other pairing problems
+        int first_problem = -1;
+        for(int i = 0; i < boards; i++) {
+            if(!fits(i)) {
                 first_problem = i;
+                break;
             }
-            transposition_eval.push_back(MatchEval(white_seekers[i], black_seekers_new[i], true));
-        } else {
-            transposition_eval.push_back(MatchEval(white_seekers[i], black_seekers_new[i], false));
         }
+        
+        if(first_problem == -1) {
+            // no problem
+            eval_games transposition_eval;
+            for(int i = 0; i < boards; i++) {
+                transposition_eval.push_back(MatchEval(white_seekers[i], by_rating[order[i]], false));
+            }
+            return std::make_shared<eval_games>(transposition_eval);
+        }
+        
+        // try another transposition
+        pof = first_problem;
     }
-    
-    // check for problems
-    if(first_problem == -1) {
-        // no problem
-        return std::make_shared<eval_games>(transposition_eval);
-    }
-    
-    // try another transposition
-    return this->nextTransposition(white_seekers, black_seekers_new, first_problem);
 }
 
 /*std::shared_ptr<CPPDubovSystem::Tournament::eval_games> CPPDubovSystem::Tournament::applyTranspositions(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers) {
@@ -790,7 +790,7 @@ std::shared_ptr<CPPDubovSystem::Tournament::eval_games> CPPDubovSystem::Tourname
     int vertex_id_white = 0;
     int vertex_id_black = ((int) white_seekers.size());
     
-    std::vector<double> cost;
+    std::vector<int> cost;
     
     int black_start_index = -1;
     std::vector<int> problems; // indecies of pairings that have a problem
@@ -889,16 +889,14 @@ std::shared_ptr<CPPDubovSystem::Tournament::eval_games> CPPDubovSystem::Tourname
     }
     
     // now that edge weights are all set, we do the matching
-    Matching m(g_main);
-    
-    std::pair<std::list<int>, double> matched = m.SolveMinimumCostPerfectMatching(cost);
+    std::pair<std::vector<int>, int> matched = this->solveMatching(g_main, cost);
     
     // make sure matching exists
     if(matched.first.size() == 0) return nullptr;
     
     // go through matchings and add them to the return
     eval_games matchings;
-    for(std::list<int>::iterator it = matched.first.begin(); it != matched.first.end(); it++) {
+    for(std::vector<int>::iterator it = matched.first.begin(); it != matched.first.end(); it++) {
         std::pair<int, int> e = g_main.GetEdge(*it);
         bool is_white_first = e.first < black_start_index;
         
@@ -914,7 +912,7 @@ std::shared_ptr<CPPDubovSystem::Tournament::eval_games> CPPDubovSystem::Tourname
     return std::make_shared<eval_games>(matchings);
 }*/
 
-void CPPDubovSystem::Tournament::evaluateTranspositions(std::vector<MatchEval> *games_eval, std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, bool *error) {
+void CPPDubovSystem::Tournament::evaluateTranspositions(std::vector<MatchEval> *games_eval, std::vector<int> &white_seekers, std::vector<int> &black_seekers, bool *error) {
     // try matching
 //    std::shared_ptr<eval_games> t2 = this->applyTranspositions(white_seekers, black_seekers);
 //    if(t2 == nullptr) {
@@ -950,7 +948,34 @@ void CPPDubovSystem::Tournament::evaluateTranspositions(std::vector<MatchEval> *
 //    std::vector<Player> ws_copy(white_seekers);
 //    std::vector<Player> bs_copy(black_seekers);
     
-    std::shared_ptr<std::vector<MatchEval>> tr = this->nextTransposition(white_seekers, black_seekers, problem_board);
+    // the search can only end with every board fixed, so without a perfect matching between the white and black seekers it would go through all the transpositions (which can be exponentially many) just to give up
+    // check for one first, which is cheap
+    int boards = (int) games_eval->size();
+    Graph g_main(2 * boards);
+    std::vector<int> side(2 * boards, 1);
+    for(int i = 0; i < boards; i++) {
+        side[i] = 0;
+        for(int z = 0; z < boards; z++) {
+            if(this->canPlay(white_seekers[i], black_seekers[z])) {
+                g_main.AddEdge(i, boards + z);
+            }
+        }
+    }
+    if(((int) BipartiteMatching<int>::SolveMaximumMatching(g_main, side).size()) < boards) {
+        // no transpositions available
+        *error = true;
+        return;
+    }
+    
+    // small brackets (the usual case) fit their masks in one or two words, so the search needs no extra allocations
+    std::shared_ptr<std::vector<MatchEval>> tr;
+    if(boards <= 64) {
+        tr = this->nextTransposition<std::array<std::uint64_t, 1>>(white_seekers, black_seekers, problem_board);
+    } else if(boards <= 128) {
+        tr = this->nextTransposition<std::array<std::uint64_t, 2>>(white_seekers, black_seekers, problem_board);
+    } else {
+        tr = this->nextTransposition<std::vector<std::uint64_t>>(white_seekers, black_seekers, problem_board);
+    }
     
     // check if transposition was found
     if(tr == nullptr) {
@@ -978,8 +1003,8 @@ void CPPDubovSystem::Tournament::evaluateTranspositions(std::vector<MatchEval> *
 //    }
 }
 
-std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::castToMatch(const std::vector<MatchEval> &games_eval) {
-    std::vector<Match> m;
+std::vector<CPPDubovSystem::SlotMatch> CPPDubovSystem::Tournament::castToMatch(const std::vector<MatchEval> &games_eval) {
+    std::vector<SlotMatch> m;
     // convert all the evaluated matches to the super class
     for(int i = 0; i < games_eval.size(); i++) {
         m.push_back(games_eval[i]);
@@ -991,7 +1016,17 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::castToMatch(const
     return m;
 }
 
-std::vector<int> CPPDubovSystem::Tournament::generateMigrationQueue(const std::vector<Player> &for_group) const {
+std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makeMatches(const std::vector<SlotMatch> &games) const {
+    std::vector<Match> m;
+    // look up the players behind the slots
+    for(int i = 0; i < games.size(); i++) {
+        m.push_back(Match(this->player(games[i].white), this->player(games[i].black), false));
+    }
+    
+    return m;
+}
+
+std::vector<int> CPPDubovSystem::Tournament::generateMigrationQueue(const std::vector<int> &for_group) const {
     std::vector<int> pq; // the queue
     
     if(for_group.size() == 0) return pq;
@@ -1033,26 +1068,26 @@ std::vector<int> CPPDubovSystem::Tournament::generateMigrationQueue(const std::v
     return pq;
 }
 
-void CPPDubovSystem::Tournament::migratePlayers(std::vector<Player> *g1, std::vector<Player> *g2) {
+void CPPDubovSystem::Tournament::migratePlayers(std::vector<int> *g1, std::vector<int> *g2) {
     //NOTE: THIS FUNCTION HAS BEEN DEPRECATED! IT IS STILL HERE TEST HELP MAKE SOME TEST CASES
     // it is assumed that g1 and g2 are all properly sorted (wether by ARO or R)
     // 4.3.3 assign sequence numbers
     std::vector<int> sequence_nums = this->generateMigrationQueue(*g2);
     // keep moving players from g2 to g1 in the order given by sequence nums until groups are of equal size
-    std::vector<Player> p_copy; // make a copy in case things don't work out well
+    std::vector<int> p_copy; // make a copy in case things don't work out well
     std::set<int> no_include;
     int n = (int) g2->size();
     while(n != g1->size() && sequence_nums.size() > 0) {
         int move = sequence_nums[0];
         sequence_nums.erase(sequence_nums.begin());
-        Player p_move = (*g2)[move];
+        int p_move = (*g2)[move];
         p_copy.push_back(p_move);
         g1->push_back(p_move);
         n -= 1;
         no_include.insert(move);
     }
     // re-create g2
-    std::vector<Player> g2_fixed;
+    std::vector<int> g2_fixed;
     for(int i = 0; i < g2->size(); i++) {
         if(no_include.contains(i)) {
             continue;
@@ -1062,24 +1097,25 @@ void CPPDubovSystem::Tournament::migratePlayers(std::vector<Player> *g1, std::ve
     *g2 = g2_fixed;
 }
 
-std::queue<CPPDubovSystem::Player> CPPDubovSystem::Tournament::generateFloatQueue(LinkedListNode &next_group, int color_imbalance) const {
-    std::queue<Player> pq;
+std::queue<int> CPPDubovSystem::Tournament::generateFloatQueue(int next_group, int color_imbalance) const {
+    std::queue<int> pq;
     
-    LinkedListNode *temp = &next_group;
-    std::queue<Player> pq_temp;
-    std::queue<Player> max_upfloat;
-    std::queue<Player> float_prev;
+    std::queue<int> pq_temp;
+    std::queue<int> max_upfloat;
+    std::queue<int> float_prev;
     
-    while(temp != nullptr) {
+    for(int g = next_group; g < this->groups.groupCount(); g++) {
         // first what is the color situation like?
         if(color_imbalance == 0) {
             // it seems like colors are completely balanced
             // so the whole group is added to the queue in the order we enter it
-            for(auto i : temp->data) {
-                if(i.upfloatedPreviously() && this->current_round != this->total_rounds) {
+            for(int k = this->groups.begin(g); k < this->groups.end(g); k++) {
+                int i = this->groups.at(k);
+                if(this->groups.isPulled(i)) continue;
+                if(this->table->upfloated_prev[i] && this->current_round != this->total_rounds) {
                     float_prev.push(i);
                     continue;
-                } else if(!i.canUpfloat(this->current_round) && this->current_round != this->total_rounds) {
+                } else if(!this->table->canUpfloat(i, this->current_round) && this->current_round != this->total_rounds) {
                     max_upfloat.push(i);
                     continue;
                 }
@@ -1098,21 +1134,22 @@ std::queue<CPPDubovSystem::Player> CPPDubovSystem::Tournament::generateFloatQueu
                 float_prev.pop();
             }
             
-            temp = temp->next;
             continue;
         }
         
         // we need to select floaters in a way where the group that needs the color (to balance out with the other group) has the priority of selection
         if(color_imbalance == 1) {
             // there are more whites
-            for(auto i : temp->data) {
-                if(i.getDueColor() == Color::WHITE) {
+            for(int k = this->groups.begin(g); k < this->groups.end(g); k++) {
+                int i = this->groups.at(k);
+                if(this->groups.isPulled(i)) continue;
+                if(this->table->due_color[i] == Color::WHITE) {
                     pq_temp.push(i);
                     continue;
-                } else if(i.upfloatedPreviously() && this->current_round != this->total_rounds) {
+                } else if(this->table->upfloated_prev[i] && this->current_round != this->total_rounds) {
                     float_prev.push(i);
                     continue;
-                } else if(!i.canUpfloat(this->current_round) && this->current_round != this->total_rounds) {
+                } else if(!this->table->canUpfloat(i, this->current_round) && this->current_round != this->total_rounds) {
                     max_upfloat.push(i);
                     continue;
                 }
@@ -1126,14 +1163,16 @@ std::queue<CPPDubovSystem::Player> CPPDubovSystem::Tournament::generateFloatQueu
             }
         } else {
             // there are more blacks
-            for(auto i : temp->data) {
-                if(i.getDueColor() == Color::BLACK) {
+            for(int k = this->groups.begin(g); k < this->groups.end(g); k++) {
+                int i = this->groups.at(k);
+                if(this->groups.isPulled(i)) continue;
+                if(this->table->due_color[i] == Color::BLACK) {
                     pq_temp.push(i);
                     continue;
-                } else if(i.upfloatedPreviously() && this->current_round != this->total_rounds) {
+                } else if(this->table->upfloated_prev[i] && this->current_round != this->total_rounds) {
                     float_prev.push(i);
                     continue;
-                } else if(!i.canUpfloat(this->current_round) && this->current_round != this->total_rounds) {
+                } else if(!this->table->canUpfloat(i, this->current_round) && this->current_round != this->total_rounds) {
                     max_upfloat.push(i);
                     continue;
                 }
@@ -1158,9 +1197,6 @@ std::queue<CPPDubovSystem::Player> CPPDubovSystem::Tournament::generateFloatQueu
             pq.push(float_prev.front());
             float_prev.pop();
         }
-        
-        // continue to the next group
-        temp = temp->next;
     }
     
     return pq;
@@ -1417,24 +1453,22 @@ std::queue<CPPDubovSystem::Player> CPPDubovSystem::Tournament::generateFloatQueu
     return upfloaters;
 }*/
 
-std::set<int> CPPDubovSystem::Tournament::findMultiUpfloatersNP(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, LinkedListNode &next_group, Graph &g, std::vector<double> &cost, const std::map<int, int> &p_convert, const std::vector<Player> &p_reverse) {
+std::set<int> CPPDubovSystem::Tournament::findMultiUpfloatersNP(std::vector<int> &white_seekers, std::vector<int> &black_seekers, int next_group, Graph &g, std::vector<int> &cost, const std::pmr::map<int, int> &p_convert, const std::pmr::vector<int> &p_reverse) {
     // it is assumed that white_seekers and black_seekers are of equal length
     // for each group, split up into white seekers and black seekers
     
     // do lower groups
-    LinkedListNode *temp = &next_group;
-    
     int max_priority = 1;
     
-    std::vector<Player> merged;
-    std::set<int> g_in;
+    std::pmr::vector<int> merged(this->scratch);
+    std::pmr::set<int> g_in(this->scratch);
     bool is_first = true;
     
-    while(temp != nullptr) {
+    for(int gr = next_group; gr < this->groups.groupCount(); gr++) {
         // divide into ws and bs
-        std::vector<Player> ws;
-        std::vector<Player> bs;
-        this->splitGroups(&ws, &bs, temp->data);
+        std::vector<int> ws;
+        std::vector<int> bs;
+        this->splitGroups(&ws, &bs, this->groups.members(gr));
         
         int priority = max_priority + 0;
         int second_priority = priority + ((int) bs.size());
@@ -1442,12 +1476,12 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloatersNP(std::vector<Play
         // and on same color should be higher
         for(auto i : white_seekers) {
             if(is_first)
-                g_in.insert(i.getID());
+                g_in.insert(i);
             for(auto z : bs) {
-                if(i.canPlayOpp(z)) {
-                    g.AddEdge(p_convert.at(i.getID()), p_convert.at(z.getID()));
+                if(this->canPlay(i, z)) {
+                    g.AddEdge(p_convert.at(i), p_convert.at(z));
                     // for determining cost, check if z has upfloated previosly or is max upfloater
-                    if(z.upfloatedPreviously() || !z.canUpfloat(this->total_rounds)) {
+                    if(this->table->upfloated_prev[z] || !this->table->canUpfloat(z, this->total_rounds)) {
                         cost.push_back(second_priority);
                         second_priority += 1;
                     } else {
@@ -1460,9 +1494,9 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloatersNP(std::vector<Play
             priority = std::max(priority, second_priority);
             second_priority = priority + ((int) ws.size());
             for(auto z : ws) {
-                if(i.canPlayOpp(z)) {
-                    g.AddEdge(p_convert.at(i.getID()), p_convert.at(z.getID()));
-                    if(z.upfloatedPreviously() || !z.canUpfloat(this->total_rounds)) {
+                if(this->canPlay(i, z)) {
+                    g.AddEdge(p_convert.at(i), p_convert.at(z));
+                    if(this->table->upfloated_prev[z] || !this->table->canUpfloat(z, this->total_rounds)) {
                         cost.push_back(second_priority);
                         second_priority += 1;
                     } else {
@@ -1479,11 +1513,11 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloatersNP(std::vector<Play
         // no do black_seekers
         for(auto i : black_seekers) {
             if(is_first)
-                g_in.insert(i.getID());
+                g_in.insert(i);
             for(auto z : ws) {
-                if(i.canPlayOpp(z)) {
-                    g.AddEdge(p_convert.at(i.getID()), p_convert.at(z.getID()));
-                    if(z.upfloatedPreviously() || !z.canUpfloat(this->total_rounds)) {
+                if(this->canPlay(i, z)) {
+                    g.AddEdge(p_convert.at(i), p_convert.at(z));
+                    if(this->table->upfloated_prev[z] || !this->table->canUpfloat(z, this->total_rounds)) {
                         cost.push_back(second_priority);
                         second_priority += 1;
                     } else {
@@ -1495,9 +1529,9 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloatersNP(std::vector<Play
             priority = std::max(priority, second_priority);
             second_priority = priority + ((int) bs.size());
             for(auto z : bs) {
-                if(i.canPlayOpp(z)) {
-                    g.AddEdge(p_convert.at(i.getID()), p_convert.at(z.getID()));
-                    if(z.upfloatedPreviously() || !z.canUpfloat(this->total_rounds)) {
+                if(this->canPlay(i, z)) {
+                    g.AddEdge(p_convert.at(i), p_convert.at(z));
+                    if(this->table->upfloated_prev[z] || !this->table->canUpfloat(z, this->total_rounds)) {
                         cost.push_back(second_priority);
                         second_priority += 1;
                     } else {
@@ -1512,16 +1546,13 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloatersNP(std::vector<Play
         
         // set new max priority
         max_priority = priority + 1;
-        
-        // shift temp
-        temp = temp->next;
     }
     
     // do rest of players
     for(int i = 0; i < merged.size(); i++) {
         for(int z = i + 1; z < merged.size(); z++) {
-            if(merged[i].canPlayOpp(merged[z])) {
-                g.AddEdge(p_convert.at(merged[i].getID()), p_convert.at(merged[z].getID()));
+            if(this->canPlay(merged[i], merged[z])) {
+                g.AddEdge(p_convert.at(merged[i]), p_convert.at(merged[z]));
                 cost.push_back(0);
             }
         }
@@ -1531,11 +1562,10 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloatersNP(std::vector<Play
     merged.clear();
     
     // do matching
-    Matching m(g);
+    int deficiency = 0;
+    std::pair<std::vector<int>, int> matched = this->solveMatching(g, cost, &p_reverse, &deficiency);
     
-    std::pair<std::list<int>, double> matched = m.SolveMinimumCostPerfectMatching(cost);
-    
-    if(matched.first.size() == 0) return std::set<int>(); // failure
+    if(deficiency > 0) return std::set<int>(); // failure, some players can't be paired whoever upfloats
     
     // loop over matchings
     int num_in = 0;
@@ -1543,17 +1573,21 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloatersNP(std::vector<Play
     
     std::set<int> upfloaters;
     // pick up upfloaters
-    for(std::list<int>::iterator it = matched.first.begin(); it != matched.first.end(); it++) {
-        std::pair<int, int> e = g.GetEdge(*it);
-        if(g_in.contains(p_reverse[e.first].getID()) && !g_in.contains(p_reverse[e.second].getID())) {
+    for(std::vector<int>::iterator it = matched.first.begin(); it != matched.first.end(); it++) {
+        std::pair<int, int> e;
+        if(g.TryGetEdge(*it, e) != GRAPH_OK) {
+            // the matching gave an edge that is not in the graph, so treat it like no matching
+            return std::set<int>();
+        }
+        if(g_in.contains(p_reverse[e.first]) && !g_in.contains(p_reverse[e.second])) {
             // upfloater found!
             num_in += 1;
-            upfloaters.insert(p_reverse[e.second].getID());
-        } else if(!g_in.contains(p_reverse[e.first].getID()) && g_in.contains(p_reverse[e.second].getID())) {
+            upfloaters.insert(p_reverse[e.second]);
+        } else if(!g_in.contains(p_reverse[e.first]) && g_in.contains(p_reverse[e.second])) {
             // upfloater found!
             num_in += 1;
-            upfloaters.insert(p_reverse[e.first].getID());
-        } else if(g_in.contains(p_reverse[e.first].getID()) && g_in.contains(p_reverse[e.second].getID())) {
+            upfloaters.insert(p_reverse[e.first]);
+        } else if(g_in.contains(p_reverse[e.first]) && g_in.contains(p_reverse[e.second])) {
             num_in += 2;
         }
         // check if the whole group was paired
@@ -1566,49 +1600,48 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloatersNP(std::vector<Play
     return upfloaters;
 }
 
-std::set<int> CPPDubovSystem::Tournament::findMultiUpfloaters(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, LinkedListNode &next_group, bool &error) {
+std::set<int> CPPDubovSystem::Tournament::findMultiUpfloaters(std::vector<int> &white_seekers, std::vector<int> &black_seekers, int next_group, bool &error) {
     // first initialize the graph
     Graph g_main(0);
-    std::map<int, int> p_convert;
-    std::vector<Player> p_reverse;
-    std::set<int> g_in;
+    std::pmr::map<int, int> p_convert(this->scratch);
+    std::pmr::vector<int> p_reverse(this->scratch);
+    std::pmr::set<int> g_in(this->scratch);
     
     int current_spot = 0;
     
     // add white seekers to graph
     for(int i = 0; i < white_seekers.size(); i++) {
         g_main.AddVertex();
-        p_convert[white_seekers[i].getID()] = current_spot;
+        p_convert[white_seekers[i]] = current_spot;
         p_reverse.push_back(white_seekers[i]);
         current_spot += 1;
-        g_in.insert(white_seekers[i].getID());
+        g_in.insert(white_seekers[i]);
     }
     
     // add black seekers to graph
     for(int i = 0; i < black_seekers.size(); i++) {
         g_main.AddVertex();
-        p_convert[black_seekers[i].getID()] = current_spot;
+        p_convert[black_seekers[i]] = current_spot;
         p_reverse.push_back(black_seekers[i]);
         current_spot += 1;
-        g_in.insert(black_seekers[i].getID());
+        g_in.insert(black_seekers[i]);
     }
     
     // also add subsequent players
-    LinkedListNode *temp1 = &next_group;
-    while(temp1 != nullptr) {
-        for(int i = 0; i < temp1->data.size(); i++) {
+    for(int gr = next_group; gr < this->groups.groupCount(); gr++) {
+        for(int i = this->groups.begin(gr); i < this->groups.end(gr); i++) {
+            int p = this->groups.at(i);
+            if(this->groups.isPulled(p)) continue;
             g_main.AddVertex();
-            p_convert[temp1->data[i].getID()] = current_spot;
-            p_reverse.push_back(temp1->data[i]);
+            p_convert[p] = current_spot;
+            p_reverse.push_back(p);
             current_spot += 1;
         }
-        
-        temp1 = temp1->next;
     }
     
     // first set up edge weights to current group
-    std::vector<double> cost;
-    std::vector<Player> merged;
+    std::vector<int> cost;
+    std::pmr::vector<int> merged(this->scratch);
 //    std::merge(white_seekers.begin(), white_seekers.end(), black_seekers.begin(), black_seekers.end(), merged.begin());
     for(auto i : white_seekers)
         merged.push_back(i);
@@ -1619,8 +1652,8 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloaters(std::vector<Player
     for(int i = 0; i < merged.size(); i++) {
         for(int z = i + 1; z < merged.size(); z++) {
             // make sure both players are compatible
-            if(merged[i].canPlayOpp(merged[z])) {
-                g_main.AddEdge(p_convert[merged[i].getID()], p_convert[merged[z].getID()]);
+            if(this->canPlay(merged[i], merged[z])) {
+                g_main.AddEdge(p_convert[merged[i]], p_convert[merged[z]]);
                 cost.push_back(0); // edge weight here doesn't matter too much. We aren't trying to get exact pairings, just get an idea of who to upfloat
             }
         }
@@ -1645,19 +1678,19 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloaters(std::vector<Player
     }
     
     // now do the lower groups
-    std::queue<Player> floater_queue = this->generateFloatQueue(next_group, imbalance);
-    std::vector<Player> q_as_vec;
+    std::queue<int> floater_queue = this->generateFloatQueue(next_group, imbalance);
+    std::pmr::vector<int> q_as_vec(this->scratch);
     
     int current_weight = 0;
     // okay now make the edge weights for this group
     while(!floater_queue.empty()) {
-        Player p_check = floater_queue.front();
+        int p_check = floater_queue.front();
         q_as_vec.push_back(p_check);
         
         for(int i = 0; i < merged.size(); i++) {
             // make sure players are compatible
-            if(merged[i].canPlayOpp(p_check)) {
-                g_main.AddEdge(p_convert[p_check.getID()], p_convert[merged[i].getID()]);
+            if(this->canPlay(merged[i], p_check)) {
+                g_main.AddEdge(p_convert[p_check], p_convert[merged[i]]);
                 cost.push_back(current_weight);
             }
         }
@@ -1670,19 +1703,19 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloaters(std::vector<Player
     // finally try making edges to the players itself
     for(int i = 0; i < q_as_vec.size(); i++) {
         for(int z = i + 1; z < q_as_vec.size(); z++) {
-            if(q_as_vec[i].canPlayOpp(q_as_vec[z])) {
-                g_main.AddEdge(p_convert[q_as_vec[i].getID()], p_convert[q_as_vec[z].getID()]);
+            if(this->canPlay(q_as_vec[i], q_as_vec[z])) {
+                g_main.AddEdge(p_convert[q_as_vec[i]], p_convert[q_as_vec[z]]);
                 cost.push_back(0); // once again, edge weight here doesn't matter what so ever
             }
         }
     }
     
     // okay now make the matching
-    Matching matching(g_main);
-    std::pair<std::list<int>, double> matched = matching.SolveMinimumCostPerfectMatching(cost);
+    int deficiency = 0;
+    std::pair<std::vector<int>, int> matched = this->solveMatching(g_main, cost, &p_reverse, &deficiency);
     
     // check if matching was a success
-    if(matched.first.size() == 0) {
+    if(deficiency > 0) {
         // failed
         error = true;
         return std::set<int>();
@@ -1692,17 +1725,22 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloaters(std::vector<Player
     
     std::set<int> upfloaters;
     // pick up upfloaters
-    for(std::list<int>::iterator it = matched.first.begin(); it != matched.first.end(); it++) {
-        std::pair<int, int> e = g_main.GetEdge(*it);
-        if(g_in.contains(p_reverse[e.first].getID()) && !g_in.contains(p_reverse[e.second].getID())) {
+    for(std::vector<int>::iterator it = matched.first.begin(); it != matched.first.end(); it++) {
+        std::pair<int, int> e;
+        if(g_main.TryGetEdge(*it, e) != GRAPH_OK) {
+            // the matching gave an edge that is not in the graph, so treat it like no matching
+            error = true;
+            return std::set<int>();
+        }
+        if(g_in.contains(p_reverse[e.first]) && !g_in.contains(p_reverse[e.second])) {
             // upfloater found!
             num_in += 1;
-            upfloaters.insert(p_reverse[e.second].getID());
-        } else if(!g_in.contains(p_reverse[e.first].getID()) && g_in.contains(p_reverse[e.second].getID())) {
+            upfloaters.insert(p_reverse[e.second]);
+        } else if(!g_in.contains(p_reverse[e.first]) && g_in.contains(p_reverse[e.second])) {
             // upfloater found!
             num_in += 1;
-            upfloaters.insert(p_reverse[e.first].getID());
-        } else if(g_in.contains(p_reverse[e.first].getID()) && g_in.contains(p_reverse[e.second].getID())) {
+            upfloaters.insert(p_reverse[e.first]);
+        } else if(g_in.contains(p_reverse[e.first]) && g_in.contains(p_reverse[e.second])) {
             num_in += 2;
         }
         // check if the whole group was paired
@@ -1715,31 +1753,24 @@ std::set<int> CPPDubovSystem::Tournament::findMultiUpfloaters(std::vector<Player
     return upfloaters;
 }
 
-CPPDubovSystem::LinkedListNode CPPDubovSystem::Tournament::makeNewGroups(const LinkedListNode &old_groups, const std::set<int> &upfloaters, std::vector<Player> *white_seekers, std::vector<Player> *black_seekers) const {
-    // go through each groups and remove them
+void CPPDubovSystem::Tournament::pullUpfloaters(int next_group, const std::set<int> &upfloaters, std::vector<int> *white_seekers, std::vector<int> *black_seekers) {
+    // go through each groups and pull them out
     // add them to ws or bs respectively
-    LinkedListNode oold_groups(old_groups);
-    LinkedListNode *temp = &oold_groups;
-    
-    while(temp != nullptr) {
-        for(int i = 0; i < temp->data.size(); i++) {
-            if(upfloaters.contains(temp->data[i].getID())) {
-                if(temp->data[i].getDueColor() == Color::WHITE) {
-                    white_seekers->push_back(temp->data[i]);
-                } else {
-                    black_seekers->push_back(temp->data[i]);
-                }
-                temp->data.erase(std::next(temp->data.begin(), i));
-                i -= 1;
+    for(int g = next_group; g < this->groups.groupCount(); g++) {
+        for(int i = this->groups.begin(g); i < this->groups.end(g); i++) {
+            int p = this->groups.at(i);
+            if(this->groups.isPulled(p) || !upfloaters.contains(p)) continue;
+            if(this->table->due_color[p] == Color::WHITE) {
+                white_seekers->push_back(p);
+            } else {
+                black_seekers->push_back(p);
             }
+            this->groups.pull(p);
         }
-        temp = temp->next;
     }
-    
-    return oold_groups;
 }
 
-std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::maximizePairings(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, bool *pairing_error) {
+std::vector<CPPDubovSystem::SlotMatch> CPPDubovSystem::Tournament::maximizePairings(std::vector<int> &white_seekers, std::vector<int> &black_seekers, bool *pairing_error) {
     eval_games games;
     std::vector<int> board_problems;
     
@@ -1749,7 +1780,7 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::maximizePairings(
     if(white_seekers.size() == black_seekers.size()) {
         for(int i = 0; i < white_seekers.size(); i++) {
 //            games.push_back(Match(white_seekers[i], black_seekers[i], false));
-            if(!white_seekers[i].canPlayOpp(black_seekers[i])) {
+            if(!this->canPlay(white_seekers[i], black_seekers[i])) {
                 problem = true;
                 games.push_back(MatchEval(white_seekers[i], black_seekers[i], true));
                 board_problems.push_back(((int) games.size()) - 1);
@@ -1772,7 +1803,7 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::maximizePairings(
             if(this->applied_shifters) {
                 // simply apply different shifters
                 *pairing_error = true;
-                return std::vector<Match>();
+                return std::vector<SlotMatch>();
             }
             
             // group sizes must have been equal originally
@@ -1788,7 +1819,7 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::maximizePairings(
             if(shifter_error) {
                 // nothing more can be done since even the graph couldn't find a way to maximize the pairings
                 *pairing_error = true;
-                return std::vector<Match>();
+                return std::vector<SlotMatch>();
             }
             
             // it is gauranteed that these shifters make the possible matches
@@ -1798,13 +1829,13 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::maximizePairings(
             
             // now create the swaps and recursively call this function again
             for(int i = 0; i < w_shifters.size(); i++) {
-                Player wc = white_seekers[w_shifters[i]];
+                int wc = white_seekers[w_shifters[i]];
                 white_seekers[w_shifters[i]] = black_seekers[b_shifters[i]];
                 black_seekers[b_shifters[i]] = wc;
             }
             
             // lastly, apply the re-sorting
-            Utils::sortPlayersRating(&black_seekers, 0, ((int) black_seekers.size()) - 1);
+            this->sortGroupRating(&black_seekers);
             this->sortGroupARO(&white_seekers, 0, ((int) white_seekers.size()) - 1);
             
             // now return a newly improved pairing
@@ -1847,7 +1878,7 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::maximizePairings(
         // now that sizes are equal, we can re-evaluate
         // we can call this function recursively since the base case was touched
         bool check = false;
-        std::vector<Match> output = this->maximizePairings(white_seekers, black_seekers, &check);
+        std::vector<SlotMatch> output = this->maximizePairings(white_seekers, black_seekers, &check);
         
         /*if(check) {
             //TODO: WILL THIS EVER BE REACHED?
@@ -1890,18 +1921,14 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::maximizePairings(
     return this->castToMatch(games);
 }
 
-int CPPDubovSystem::Tournament::removeByePlayer(std::vector<Player> *players, int bye_remove, Player *p_bye) const {
-    int r = -1;
-    // find where the bye player is and remove the player from the list
-    for(int i = 0; i < players->size(); i++) {
-        if((*players)[i].getID() == bye_remove) {
-            *p_bye = (*players)[i];
-            players->erase(std::next(players->begin(), i));
-            r = i;
-            break;
+int CPPDubovSystem::Tournament::findSlot(int id) const {
+    // find where the player is and give back the slot
+    for(int i = 0; i < this->ranking.size(); i++) {
+        if(this->table->id[this->ranking[i]] == id) {
+            return this->ranking[i];
         }
     }
-    return r;
+    return -1;
 }
 
 int CPPDubovSystem::Tournament::playerShouldAlternate(Player &white, Player &black) {
@@ -1954,17 +1981,17 @@ int CPPDubovSystem::Tournament::playerShouldAlternate(Player &white, Player &bla
     return black.getID(); // we know that the strengths are not the same, so no need to compare anything else
 }
 
-void CPPDubovSystem::Tournament::optimizeColors(std::vector<Match> *games) {
+void CPPDubovSystem::Tournament::optimizeColors(std::vector<SlotMatch> *games) {
     // since the program already makes sure that absolute criteria is met, just make sure equalization is preferred to alternation
     for(int i = 0; i < games->size(); i++) {
-        if((*games)[i].is_bye) {
-            continue;
-        }
-        Color gc = (*games)[i].white.getDueColor();
-        if(gc == (*games)[i].black.getDueColor()) {
+        // the engine never produces byes here, so both slots always hold a player
+        Player &white = this->player((*games)[i].white);
+        Player &black = this->player((*games)[i].black);
+        Color gc = white.getDueColor();
+        if(gc == black.getDueColor()) {
             //TODO: A FEW TEST CASES STILL YIELD SOME WEIRD INVALID COLORS BECAUSE OF RULE 5.2.4. SOME MORE TESTING FOR THIS RULE IN PARTICULAR IS NEEDED
-            ColorPreference wp = (*games)[i].white.getPreferenceStrength();
-            ColorPreference bp = (*games)[i].black.getPreferenceStrength();
+            ColorPreference wp = white.getPreferenceStrength();
+            ColorPreference bp = black.getPreferenceStrength();
             /*if((wp == ColorPreference::ALTERNATION && bp == ColorPreference::MILD && gc == Color::WHITE) || (gc == Color::WHITE && bp == ColorPreference::ABSOLUTE)) {
                 // bp has higher priority
                 (*games)[i] = Match((*games)[i].black, (*games)[i].white, false);
@@ -1995,11 +2022,11 @@ void CPPDubovSystem::Tournament::optimizeColors(std::vector<Match> *games) {
             pref_equiv[ColorPreference::NO_PREFERENCE] = 0;
             if(gc == Color::WHITE) {
                 if(pref_equiv[bp] > pref_equiv[wp]) {
-                    (*games)[i] = Match((*games)[i].black, (*games)[i].white, false);
+                    std::swap((*games)[i].white, (*games)[i].black);
                 } else if(pref_equiv[bp] == pref_equiv[wp]) {
                     // check if black should be swapped
-                    if((*games)[i].black.shouldAlternate((*games)[i].white)) {
-                        (*games)[i] = Match((*games)[i].black, (*games)[i].white, false);
+                    if(black.shouldAlternate(white)) {
+                        std::swap((*games)[i].white, (*games)[i].black);
                     }
                 }
 //                if(this->playerShouldAlternate((*games)[i].white, (*games)[i].black) == (*games)[i].black.getID()) {
@@ -2007,11 +2034,11 @@ void CPPDubovSystem::Tournament::optimizeColors(std::vector<Match> *games) {
 //                }
             } else if(gc == Color::BLACK) {
                 if(pref_equiv[wp] > pref_equiv[bp]) {
-                    (*games)[i] = Match((*games)[i].black, (*games)[i].white, false);
+                    std::swap((*games)[i].white, (*games)[i].black);
                 } else if(pref_equiv[wp] == pref_equiv[bp]) {
                     // check if white should be swapped
-                    if((*games)[i].white.shouldAlternate((*games)[i].black)) {
-                        (*games)[i] = Match((*games)[i].black, (*games)[i].white, false);
+                    if(white.shouldAlternate(black)) {
+                        std::swap((*games)[i].white, (*games)[i].black);
                     }
                 }
 //                if(this->playerShouldAlternate((*games)[i].white, (*games)[i].black) == (*games)[i].white.getID()) {
@@ -2034,25 +2061,25 @@ void CPPDubovSystem::Tournament::optimizeColors(std::vector<Match> *games) {
 //                        (*games)[i] = Match((*games)[i].black, (*games)[i].white, false);
 //                    }
 //                }
-                if((*games)[i].white < (*games)[i].black && (*games)[i].black.getID() % 2 == 0) {
+                if(white < black && black.getID() % 2 == 0) {
                     // we do the swap!
-                    (*games)[i] = Match((*games)[i].black, (*games)[i].white, false);
-                } else if((*games)[i].white > (*games)[i].black && (*games)[i].white.getID() % 2 == 0) {
+                    std::swap((*games)[i].white, (*games)[i].black);
+                } else if(white > black && white.getID() % 2 == 0) {
                     // we also do the swap!
-                    (*games)[i] = Match((*games)[i].black, (*games)[i].white, false);
+                    std::swap((*games)[i].white, (*games)[i].black);
                 }
             }
         } else {
             // check if one player doesn't have a color preference
             if(gc == Color::NO_COLOR) {
                 // check if black has a preference for white
-                if((*games)[i].black.getDueColor() == Color::WHITE) {
-                    (*games)[i] = Match((*games)[i].black, (*games)[i].white, false);
+                if(black.getDueColor() == Color::WHITE) {
+                    std::swap((*games)[i].white, (*games)[i].black);
                 }
             } else {
                 // check if black player has no preference and white wants black
-                if((*games)[i].black.getDueColor() == Color::NO_COLOR && gc == Color::BLACK) {
-                    (*games)[i] = Match((*games)[i].black, (*games)[i].white, false);
+                if(black.getDueColor() == Color::NO_COLOR && gc == Color::BLACK) {
+                    std::swap((*games)[i].white, (*games)[i].black);
                 }
             }
         }
@@ -2066,11 +2093,16 @@ CPPDubovSystem::Tournament::Tournament(int total_rounds) {
 void CPPDubovSystem::Tournament::addPlayer(const Player &p) {
     this->player_count += 1; // increment player count as needed
     this->players.push_back(p);
+    // the slot is simply the position the player was added in
+    this->players.back().setSlot(((int) this->players.size()) - 1);
+    this->players.back().internName(*this->names);
 }
 
 void CPPDubovSystem::Tournament::addPlayer(Player &&p) {
     this->player_count += 1;
     this->players.push_back(p);
+    this->players.back().setSlot(((int) this->players.size()) - 1);
+    this->players.back().internName(*this->names);
 }
 
 CPPDubovSystem::Match::Match(const Player &white, const Player &black, bool is_bye) {
@@ -2079,230 +2111,49 @@ CPPDubovSystem::Match::Match(const Player &white, const Player &black, bool is_b
     this->black = black;
 }
 
-void CPPDubovSystem::Utils::playersRatingMerge(std::vector<Player> *players, const int left, const int mid, const int right) {
-    int const subVectorOne = mid - left + 1;
-    int const subVectorTwo = right - mid;
-    
-    auto *leftVector = new std::vector<Player>(), *rightVector = new std::vector<Player>();
-//    leftVector->reserve(subVectorOne);
-    leftVector->resize(subVectorOne);
-    rightVector->resize(subVectorTwo);
-    
-    for(auto i = 0; i < subVectorOne; i++) {
-        (*leftVector)[i] = (*players)[left + i];
-    }
-    for(auto i = 0; i < subVectorTwo; i++) {
-        (*rightVector)[i] = (*players)[mid + 1 + i];
-    }
-    
-    auto indexOfVectorOne = 0, indexOfVectorTwo = 0;
-    int indexOfMergedVector = left;
-    
-    while(indexOfVectorOne < subVectorOne && indexOfVectorTwo < subVectorTwo) {
-        /*if((*leftVector)[indexOfVectorOne].getRating() >= (*rightVector)[indexOfVectorTwo].getRating()) {
-            // if ratings are equal, choose the higher starting rank
-            if((*leftVector)[indexOfVectorOne].getRating() == (*rightVector)[indexOfVectorTwo].getRating()) {
-                if((*leftVector)[indexOfVectorOne].getID() < (*rightVector)[indexOfVectorTwo].getID()) {
-                    (*players)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-                    indexOfVectorOne += 1;
-                } else {
-                    (*players)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-                    indexOfVectorTwo += 1;
-                }
-            } else {
-                (*players)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-                indexOfVectorOne += 1;
-            }
-        } else {
-            (*players)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-            indexOfVectorTwo += 1;
-        }*/
-        if((*leftVector)[indexOfVectorOne].getID() < (*rightVector)[indexOfVectorTwo].getID()) {
-            (*players)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-            indexOfVectorOne += 1;
-        } else {
-            (*players)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-            indexOfVectorTwo += 1;
-        }
-        indexOfMergedVector += 1;
-    }
-    
-    while(indexOfVectorOne < subVectorOne) {
-        (*players)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-        indexOfVectorOne += 1;
-        indexOfMergedVector += 1;
-    }
-    
-    while(indexOfVectorTwo < subVectorTwo) {
-        (*players)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-        indexOfVectorTwo += 1;
-        indexOfMergedVector += 1;
-    }
-    
-    delete leftVector;
-    delete rightVector;
-}
-
-void CPPDubovSystem::Utils::playersRatingRTGMerge(std::vector<Player> *players, const int left, const int mid, const int right) {
-    int const subVectorOne = mid - left + 1;
-    int const subVectorTwo = right - mid;
-    
-    auto *leftVector = new std::vector<Player>(), *rightVector = new std::vector<Player>();
-//    leftVector->reserve(subVectorOne);
-    leftVector->resize(subVectorOne);
-    rightVector->resize(subVectorTwo);
-    
-    for(auto i = 0; i < subVectorOne; i++) {
-        (*leftVector)[i] = (*players)[left + i];
-    }
-    for(auto i = 0; i < subVectorTwo; i++) {
-        (*rightVector)[i] = (*players)[mid + 1 + i];
-    }
-    
-    auto indexOfVectorOne = 0, indexOfVectorTwo = 0;
-    int indexOfMergedVector = left;
-    
-    while(indexOfVectorOne < subVectorOne && indexOfVectorTwo < subVectorTwo) {
-        if((*leftVector)[indexOfVectorOne].getRating() >= (*rightVector)[indexOfVectorTwo].getRating()) {
-            // if ratings are equal, choose the higher starting rank
-            if((*leftVector)[indexOfVectorOne].getRating() == (*rightVector)[indexOfVectorTwo].getRating()) {
-                if((*leftVector)[indexOfVectorOne].getID() < (*rightVector)[indexOfVectorTwo].getID()) {
-                    (*players)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-                    indexOfVectorOne += 1;
-                } else {
-                    (*players)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-                    indexOfVectorTwo += 1;
-                }
-            } else {
-                (*players)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-                indexOfVectorOne += 1;
-            }
-        } else {
-            (*players)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-            indexOfVectorTwo += 1;
-        }
-        indexOfMergedVector += 1;
-    }
-    
-    while(indexOfVectorOne < subVectorOne) {
-        (*players)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-        indexOfVectorOne += 1;
-        indexOfMergedVector += 1;
-    }
-    
-    while(indexOfVectorTwo < subVectorTwo) {
-        (*players)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-        indexOfVectorTwo += 1;
-        indexOfMergedVector += 1;
-    }
-    
-    delete leftVector;
-    delete rightVector;
-}
-
-void CPPDubovSystem::Tournament::playersPointsMerge(std::vector<Player> *players, const int left, const int mid, const int right) {
-    int const subVectorOne = mid - left + 1;
-    int const subVectorTwo = right - mid;
-    
-    auto *leftVector = new std::vector<Player>(), *rightVector = new std::vector<Player>();
-//    leftVector->reserve(subVectorOne);
-    leftVector->resize(subVectorOne);
-    rightVector->resize(subVectorTwo);
-    
-    for(auto i = 0; i < subVectorOne; i++) {
-        (*leftVector)[i] = (*players)[left + i];
-    }
-    for(auto i = 0; i < subVectorTwo; i++) {
-        (*rightVector)[i] = (*players)[mid + 1 + i];
-    }
-    
-    auto indexOfVectorOne = 0, indexOfVectorTwo = 0;
-    int indexOfMergedVector = left;
-    
-    while(indexOfVectorOne < subVectorOne && indexOfVectorTwo < subVectorTwo) {
-        if((*leftVector)[indexOfVectorOne].getPoints() >= (*rightVector)[indexOfVectorTwo].getPoints()) {
-            (*players)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-            indexOfVectorOne += 1;
-        } else {
-            (*players)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-            indexOfVectorTwo += 1;
-        }
-        indexOfMergedVector += 1;
-    }
-    
-    while(indexOfVectorOne < subVectorOne) {
-        (*players)[indexOfMergedVector] = (*leftVector)[indexOfVectorOne];
-        indexOfVectorOne += 1;
-        indexOfMergedVector += 1;
-    }
-    
-    while(indexOfVectorTwo < subVectorTwo) {
-        (*players)[indexOfMergedVector] = (*rightVector)[indexOfVectorTwo];
-        indexOfVectorTwo += 1;
-        indexOfMergedVector += 1;
-    }
-    
-    delete leftVector;
-    delete rightVector;
-}
-
 void CPPDubovSystem::Utils::sortPlayersRating(std::vector<Player> *players, const int begin, const int end) {
-    if(begin >= end) {
-        return;
-    }
-    
-    int mid = begin + (end - begin) / 2;
-    Utils::sortPlayersRating(players, begin, mid);
-    Utils::sortPlayersRating(players, mid + 1, end);
-    Utils::playersRatingMerge(players, begin, mid, end);
+    // players are ordered by pairing number
+    Utils::sortByKey(players, begin, end, [](const Player &p) {
+        return (std::uint64_t) Utils::orderedKey(p.getID());
+    });
 }
 
 void CPPDubovSystem::Utils::sortPlayersRatingRTG(std::vector<Player> *players, const int begin, const int end) {
-    if(begin >= end) {
-        return;
-    }
-    
-    int mid = begin + (end - begin) / 2;
-    Utils::sortPlayersRatingRTG(players, begin, mid);
-    Utils::sortPlayersRatingRTG(players, mid + 1, end);
-    Utils::playersRatingRTGMerge(players, begin, mid, end);
+    // higher rating goes first, and if ratings are equal, choose the higher starting rank
+    Utils::sortByKey(players, begin, end, [](const Player &p) {
+        return (((std::uint64_t) ~Utils::orderedKey(p.getRating())) << 32) | Utils::orderedKey(p.getID());
+    });
 }
 
 void CPPDubovSystem::Tournament::sortPlayersPoints(std::vector<Player> *players, const int begin, const int end) {
-    if(begin >= end) {
-        return;
-    }
-    
-    int mid = begin + (end - begin) / 2;
-//    this->sortPlayersPoints(players, begin, mid);
-//    this->sortPlayersPoints(players, mid + 1, end);
-//    this->playersPointsMerge(players, begin, mid, end);
-    sortPlayersPoints(players, begin, mid);
-    sortPlayersPoints(players, mid + 1, end);
-    playersPointsMerge(players, begin, mid, end);
+    // higher points go first, players with the same points keep their order
+    Utils::sortByKey(players, begin, end, [](const Player &p) {
+        return (std::uint64_t) ~Utils::orderedKey(p.getHalfPoints());
+    });
 }
 
-std::vector<int> CPPDubovSystem::Tournament::getByePlayerStack(const std::vector<Player> &selection, int current_round) const {
+std::vector<int> CPPDubovSystem::Tournament::getByePlayerStack(const std::vector<int> &selection, int current_round) const {
     // find the player with the lowest rank, played the highest number of games, and has not scored a forfeit win or gotten a bye before
+    // selection holds slots in pairing order
     int lowest = ((int) selection.size()) - 1;
     std::vector<int> candidate_player;
     std::vector<int> bye_queue;
     std::priority_queue<std::pair<int, int>> next_candidate;
-    double prev_points = -1.0;
+    int prev_points = -1;
     while(lowest >= 0) {
-        if(prev_points == -1.0) {
-            prev_points = selection[lowest].getPoints();
+        if(prev_points == -1) {
+            prev_points = this->table->score[selection[lowest]];
         }
         // make sure player hasn't scored forfeit win and hasn't gotten bye before
-        if(selection[lowest].hasReceievedBye()) {
+        if(this->table->received_bye[selection[lowest]]) {
             // invalid
             lowest -= 1;
             continue;
         }
         
         // compare points
-        if(selection[lowest].getPoints() != prev_points) {
-            prev_points = selection[lowest].getPoints();
+        if(this->table->score[selection[lowest]] != prev_points) {
+            prev_points = this->table->score[selection[lowest]];
             // add all in candidate
             while(!next_candidate.empty()) {
                 bye_queue.push_back(next_candidate.top().second);
@@ -2311,10 +2162,10 @@ std::vector<int> CPPDubovSystem::Tournament::getByePlayerStack(const std::vector
         }
         
         // 2.1.4 player should have played highest number of games
-        if(selection[lowest].getOppCount() < current_round - 1) {
+        if(this->table->opp_count[selection[lowest]] < current_round - 1) {
             // hasn't played highest number of games, but is a candidate
-            candidate_player.push_back(selection[lowest].getID());
-            next_candidate.push(std::make_pair(selection[lowest].getOppCount(), selection[lowest].getID()));
+            candidate_player.push_back(this->table->id[selection[lowest]]);
+            next_candidate.push(std::make_pair(this->table->opp_count[selection[lowest]], this->table->id[selection[lowest]]));
             lowest -= 1;
             continue;
         }
@@ -2329,7 +2180,7 @@ std::vector<int> CPPDubovSystem::Tournament::getByePlayerStack(const std::vector
 //        }
         
         // player can get bye
-        bye_queue.push_back(selection[lowest].getID());
+        bye_queue.push_back(this->table->id[selection[lowest]]);
         lowest -= 1;
         // 2.1.3 player should have lowest score
     }
@@ -2370,7 +2221,7 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makeRound1() {
         }
     }
     if(this->player_count % 2 > 0) {
-        games.push_back(Match(this->players[this->player_count - 1], Player("", 0, -1, 0.0), true));
+        games.push_back(Match(this->players[this->player_count - 1], Player("", 0, -1, 0.0, *this->names), true));
     }
     return games;
 }
@@ -2533,27 +2384,26 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makeRoundRobinRou
     return games;
 }
 
-CPPDubovSystem::LinkedList CPPDubovSystem::Tournament::makeGroups() const {
-    LinkedList groups;
-    // it is assumed that players are already sorted
-    std::vector<Player> group;
-    group.push_back(this->players[0]);
-    double curr_points = this->players[0].getPoints();
-    
-    // go through all the players and insert them into their own linkedlistnode container
-    for(int i = 1; i < this->player_count; i++) {
-        if(this->players[i].getPoints() != curr_points) {
-            groups.insertNode(group);
-            group.clear();
-            group.push_back(this->players[i]);
-            curr_points = this->players[i].getPoints();
-            continue;
+CPPDubovSystem::ScoreGroups CPPDubovSystem::Tournament::makeGroups(int bye_slot) const {
+    std::vector<int> slots;
+    std::vector<int> group_start;
+    slots.reserve(this->ranking.size());
+    group_start.push_back(0);
+    // it is assumed that players are already ranked, so each score group is just a range of the ranking
+    for(int g = 0; g + 1 < this->score_start.size(); g++) {
+        for(int i = this->score_start[g]; i < this->score_start[g + 1]; i++) {
+            // the bye player sits this round out
+            if(this->ranking[i] == bye_slot) continue;
+            
+            slots.push_back(this->ranking[i]);
+        }
+        // the group is gone if the bye player was the only one in it
+        if(slots.size() > group_start.back()) {
+            group_start.push_back((int) slots.size());
         }
-        group.push_back(this->players[i]);
     }
-    groups.insertNode(group);
     
-    return groups;
+    return ScoreGroups(std::move(slots), std::move(group_start), (int) this->table->id.size());
 }
 
 void CPPDubovSystem::Tournament::initPlayers() {
@@ -2563,12 +2413,8 @@ void CPPDubovSystem::Tournament::initPlayers() {
     // we will also validate that each player has a unique id and is not unrated
     std::set<int> unique_id;
     for(int i = 0; i < this->players.size(); i++) {
-        // the due color and strength are automatically initialized internally
-        this->players[i].getDueColor();
-        this->players[i].getPreferenceStrength();
-        // also set up aro
-        this->players[i].getARO();
-        // also make sure the id is unique
+        // the due color, strength and aro are all kept up to date as the player is built, so only the id needs checking
+        // make sure the id is unique
         // the id is unique of unique_id doesn't contain the id already
         if(unique_id.contains(this->players[i].getID())) {
             std::cerr << "The player ID " << std::to_string(this->players[i].getID()) << " is a duplicate ID (another player already has this ID in the tournament). This could give invalid pairings." << std::endl;
@@ -2582,54 +2428,287 @@ void CPPDubovSystem::Tournament::initPlayers() {
             std::cerr << "Player with ID " << std::to_string(this->players[i].getID()) << " appears to be unrated. All players in this pairing system must have a rating (rule 1.1.1)." << std::endl;
         }
     }
+    
+    // the pairing engine refers to players by slot, so keep track of where each slot lives
+    // players must not be added or removed while pairing, since that would move them around
+    int n = 0;
+    for(int i = 0; i < this->players.size(); i++) {
+        n = std::max(n, this->players[i].getSlot() + 1);
+    }
+    this->by_slot.assign(n, -1);
+    for(int i = 0; i < this->players.size(); i++) {
+        this->by_slot[this->players[i].getSlot()] = i;
+    }
+    
+    // take the column snapshot the sorting and grouping steps read from
+    std::shared_ptr<PlayerTable> snapshot = std::make_shared<PlayerTable>();
+    snapshot->build(this->players);
+    this->table = snapshot;
+    
+    // now that all due colors are known, we can figure out who can play who
+    this->buildCompatibility();
 }
 
-std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makePairingForGroup(LinkedListNode *g, int pairing_round) {
-    if(g == nullptr) {
+void CPPDubovSystem::Tournament::rankPlayers() {
+    // first put the players in pairing number order
+    // start from the order the players are in, so players who tie on everything keep that order
+    std::vector<int> by_number;
+    for(int i = 0; i < this->players.size(); i++) {
+        by_number.push_back(this->players[i].getSlot());
+    }
+    Utils::sortByKey(&by_number, 0, ((int) by_number.size()) - 1, [this](int s) {
+        return (std::uint64_t) Utils::orderedKey(this->table->id[s]);
+    });
+    
+    this->ranking.assign(by_number.size(), -1);
+    this->score_start.clear();
+    if(by_number.empty()) {
+        this->score_start.push_back(0);
+        return;
+    }
+    
+    // now do a counting sort on the scores, highest score first
+    // this is stable, so within the same score the lower pairing number still goes first
+    int low = this->table->score[by_number[0]];
+    int high = low;
+    for(int s : by_number) {
+        low = std::min(low, this->table->score[s]);
+        high = std::max(high, this->table->score[s]);
+    }
+    std::vector<int> start(high - low + 2, 0);
+    for(int s : by_number) {
+        start[high - this->table->score[s] + 1] += 1;
+    }
+    for(int i = 0; i + 1 < start.size(); i++) {
+        start[i + 1] += start[i];
+    }
+    // every score which somebody has becomes a score group
+    for(int i = 0; i + 1 < start.size(); i++) {
+        if(start[i + 1] > start[i]) {
+            this->score_start.push_back(start[i]);
+        }
+    }
+    this->score_start.push_back((int) by_number.size());
+    for(int s : by_number) {
+        this->ranking[start[high - this->table->score[s]]++] = s;
+    }
+}
+
+void CPPDubovSystem::PlayerTable::build(std::vector<Player> &players) {
+    int n = 0;
+    for(int i = 0; i < players.size(); i++) {
+        n = std::max(n, players[i].getSlot() + 1);
+    }
+    this->id.assign(n, 0);
+    this->score.assign(n, 0);
+    this->rating.assign(n, 0);
+    this->aro.assign(n, 0.0);
+    this->due_color.assign(n, Color::NO_COLOR);
+    this->strength.assign(n, ColorPreference::NO_PREFERENCE);
+    this->num_upfloated.assign(n, 0);
+    this->upfloated_prev.assign(n, false);
+    this->received_bye.assign(n, false);
+    this->opp_count.assign(n, 0);
+    
+    // copy each player into its row
+    for(int i = 0; i < players.size(); i++) {
+        int s = players[i].getSlot();
+        this->id[s] = players[i].getID();
+        this->score[s] = players[i].getHalfPoints();
+        this->rating[s] = players[i].getRating();
+        this->aro[s] = players[i].getARO();
+        this->due_color[s] = players[i].getDueColor();
+        this->strength[s] = players[i].getPreferenceStrength();
+        this->num_upfloated[s] = players[i].getNumUpfloat();
+        this->upfloated_prev[s] = players[i].upfloatedPreviously();
+        this->received_bye[s] = players[i].hasReceievedBye();
+        this->opp_count[s] = players[i].getOppCount();
+    }
+}
+
+void CPPDubovSystem::Tournament::buildCompatibility() {
+    // the matrix has one row for each slot, and each row has one bit for each slot
+    int n = 0;
+    for(int i = 0; i < this->players.size(); i++) {
+        n = std::max(n, this->players[i].getSlot() + 1);
+    }
+    this->compatibility_stride = (n + 63) / 64;
+    std::shared_ptr<std::vector<std::uint64_t>> matrix = std::make_shared<std::vector<std::uint64_t>>(((std::size_t) n) * this->compatibility_stride, 0);
+    
+    // we need to look up slots by id since opponents and restrictions are stored by id
+    std::vector<std::pair<int, int>> id_slot;
+    // all slots in use, and the slots of players with an absolute preference for each color
+    std::vector<std::uint64_t> in_use(this->compatibility_stride);
+    std::vector<std::vector<std::uint64_t>> absolute(3, std::vector<std::uint64_t>(this->compatibility_stride));
+    for(int i = 0; i < this->players.size(); i++) {
+        int s = this->players[i].getSlot();
+        id_slot.push_back(std::make_pair(this->players[i].getID(), s));
+        in_use[s >> 6] |= std::uint64_t(1) << (s & 63);
+        if(this->players[i].getPreferenceStrength() == ColorPreference::ABSOLUTE) {
+            absolute[this->players[i].getDueColor()][s >> 6] |= std::uint64_t(1) << (s & 63);
+        }
+    }
+    
+    std::sort(id_slot.begin(), id_slot.end());
+    
+    // start with everyone being able to play everyone
+    // except players who both have the same absolute color preference
+    for(int i = 0; i < this->players.size(); i++) {
+        int s = this->players[i].getSlot();
+        std::uint64_t *row = &(*matrix)[((std::size_t) s) * this->compatibility_stride];
+        bool is_absolute = this->players[i].getPreferenceStrength() == ColorPreference::ABSOLUTE;
+        Color due = this->players[i].getDueColor();
+        for(int w = 0; w < this->compatibility_stride; w++) {
+            row[w] = in_use[w];
+            if(is_absolute) {
+                row[w] &= ~absolute[due][w];
+            }
+        }
+        // a player can never play themself
+        row[s >> 6] &= ~(std::uint64_t(1) << (s & 63));
+    }
+    
+    // now take out all opponents played and all pairing restrictions
+    // this is done from both sides, so the matrix is always symmetric
+    auto forbid = [this, &id_slot, &matrix](int s, int opp_id) {
+        auto it = std::lower_bound(id_slot.begin(), id_slot.end(), std::make_pair(opp_id, -1));
+        for(; it != id_slot.end() && it->first == opp_id; it++) {
+            int o = it->second;
+            (*matrix)[((std::size_t) s) * this->compatibility_stride + (o >> 6)] &= ~(std::uint64_t(1) << (o & 63));
+            (*matrix)[((std::size_t) o) * this->compatibility_stride + (s >> 6)] &= ~(std::uint64_t(1) << (s & 63));
+        }
+    };
+    for(int i = 0; i < this->players.size(); i++) {
+        int s = this->players[i].getSlot();
+        for(int opp_id : this->players[i].getOppPlayed()) {
+            forbid(s, opp_id);
+        }
+        for(int opp_id : this->players[i].getPairingRestrictions()) {
+            forbid(s, opp_id);
+        }
+    }
+    
+    // the matrix is never changed from here on, so the worker copies of the engine can share it
+    this->compatibility = matrix;
+}
+
+bool CPPDubovSystem::Tournament::outOfBudget() {
+    if(this->stats.out_of_budget) {
+        return true;
+    }
+    // a speculative pairing which is not needed any more stops right away
+    if(this->isCancelled()) {
+        return true;
+    }
+    if(this->budget.max_nodes > 0 && this->stats.nodes >= this->budget.max_nodes) {
+        this->stats.out_of_budget = true;
+    } else {
+        this->outOfTime();
+    }
+    return this->stats.out_of_budget;
+}
+
+bool CPPDubovSystem::Tournament::outOfTime() {
+    if(this->deadline > 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - this->search_start).count() > this->deadline) {
+        this->stats.out_of_budget = true;
+        return true;
+    }
+    return false;
+}
+
+bool CPPDubovSystem::Tournament::isCancelled() const {
+    return this->cancelled != nullptr && this->cancelled->load();
+}
+
+std::vector<int> CPPDubovSystem::Tournament::bracketKey(int g) const {
+    // the group is known by its score, since the groups below it hold everybody with a lower score
+    int score = this->table->score[this->groups.at(this->groups.begin(g))];
+    std::vector<int> key = {score, -1};
+    if(this->current_bye != -1 && this->table->score[this->current_bye] <= score) {
+        key[1] = this->current_bye;
+    }
+    // then everybody who was pulled up, in ranking order
+    for(int i = this->groups.begin(g); i < this->groups.begin(this->groups.groupCount()); i++) {
+        if(this->groups.isPulled(this->groups.at(i))) {
+            key.push_back(this->groups.at(i));
+        }
+    }
+    return key;
+}
+
+std::vector<CPPDubovSystem::SlotMatch> CPPDubovSystem::Tournament::makePairingForGroup(int g, int pairing_round) {
+    if(g >= this->groups.groupCount()) {
         // base case
-        return std::vector<Match>();
+        return std::vector<SlotMatch>();
     }
-    std::vector<Match> games;
-    Player upfloater; // for storing upfloater in backtracking
-    bool contains_upfloaters = false;
     
-    std::vector<Player> white_seekers;
-    std::vector<Player> black_seekers;
-    std::vector<Player> upfloaters;
-    std::vector<Player> upfloaters_multi;
+    // nothing more is tried once the search is out of budget or cancelled
+    if(this->stats.out_of_budget || this->isCancelled()) {
+        this->pairing_error = true;
+        return std::vector<SlotMatch>();
+    }
+    
+    // the same bracket comes up again and again while backtracking (and again for every bye player tried), so check if it already failed
+    // only failures need remembering, since once the lower groups are paired the whole round is done
+    std::vector<int> key = this->bracketKey(g);
+    std::map<std::vector<int>, bool>::iterator failed = this->failed_brackets.find(key);
+    if(failed != this->failed_brackets.end()) {
+        this->stats.failed_bracket_hits += 1;
+        this->past_last_group = this->past_last_group || failed->second;
+        this->pairing_error = true;
+        return std::vector<SlotMatch>();
+    }
+    
+    bool past_before = this->past_last_group;
+    this->past_last_group = false;
+    std::vector<SlotMatch> games = this->pairGroup(g, pairing_round);
+    // running out of budget or being cancelled says nothing about the bracket itself
+    // (the flag is only ever set, so if it is clear now the whole search of the bracket ran uncancelled)
+    if(this->pairing_error && !this->stats.out_of_budget && !this->isCancelled()) {
+        this->failed_brackets[key] = this->past_last_group;
+    }
+    this->past_last_group = past_before || this->past_last_group;
+    
+    return games;
+}
+
+std::vector<CPPDubovSystem::SlotMatch> CPPDubovSystem::Tournament::pairGroup(int g, int pairing_round) {
+    std::vector<SlotMatch> games;
+    bool has_next = g + 1 < this->groups.groupCount();
+    
+    std::vector<int> white_seekers;
+    std::vector<int> black_seekers;
+    std::vector<int> upfloaters;
+    std::vector<int> upfloaters_multi;
     bool floater_required = false;
     
     // make groups
-    this->splitGroups(&white_seekers, &black_seekers, g->data);
+    std::vector<int> group = this->groups.members(g);
+    this->splitGroups(&white_seekers, &black_seekers, group);
     
     // sort groups
     this->sortGroupARO(&white_seekers, 0, ((int) white_seekers.size()) - 1);
-    Utils::sortPlayersRating(&black_seekers, 0, ((int) black_seekers.size()) - 1);
+    this->sortGroupRating(&black_seekers);
     
     int num_white = (int) white_seekers.size();
     int num_black = (int) black_seekers.size();
     
     // now check if upfloater is needed for this group in order to complete pairings
-    if(g->data.size() % 2 > 0) {
+    if(group.size() % 2 > 0) {
         // make sure there is a next group
-        if(g->next == nullptr) {
+        if(!has_next) {
             // can't do anything more from here!
+            this->past_last_group = true;
             this->pairing_error = true;
-            if(contains_upfloaters) {
-                g->data.push_back(upfloater);
-            }
-            return std::vector<Match>();
+            return std::vector<SlotMatch>();
         }
         // find upfloater that satisfies pairings
-        upfloaters = this->findUpfloaters(*g->next, num_white - num_black);
+        upfloaters = this->findUpfloaters(g + 1, num_white - num_black);
         
         // make sure there is at least one valid upfloater present
         if(upfloaters.size() == 0) {
+            this->past_last_group = true;
             this->pairing_error = true;
-            // put back upfloater if needed
-            if(contains_upfloaters) {
-                g->data.push_back(upfloater);
-            }
             return games;
         }
         floater_required = true;
@@ -2638,94 +2717,99 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makePairingForGro
     // attempt to pair the group
     bool pair_complete = false;
     bool pairing_failure_upfloaters = false;
-    std::vector<Player> upfloaters_move_container; // for storing tried upfloaters
+    std::vector<int> upfloaters_move_container; // for storing tried upfloaters
 //    unsigned int max_upfloater_move = 2;
+    // anything pulled out of the lower groups after this point belongs to an attempt at this group
+    int mark = this->groups.mark();
+    int floaters_tried = 0;
     while(!pair_complete) {
-        // make copies as needed
-        std::vector<Player> w_copy = std::vector<Player>(white_seekers);
-        std::vector<Player> b_copy = std::vector<Player>(black_seekers);
-        LinkedListNode *next_group_use = g->next == nullptr ? nullptr : (new LinkedListNode(*(g->next)));
+        // put back everyone pulled by the last attempt (including by the lower groups)
+        this->groups.undo(mark);
+        // every attempt counts against the budget
+        if(this->outOfBudget()) {
+            this->pairing_error = true;
+            break;
+        }
+        this->stats.nodes += 1;
         // check if we have any floaters
         if(floater_required) {
             if(upfloaters.size() == 0) {
                 // no floaters left
+                this->past_last_group = true;
                 this->pairing_error = true;
-                if(contains_upfloaters) {
-                    g->data.push_back(upfloater);
-                }
-                if(next_group_use != nullptr) delete next_group_use;
                 return games;
             }
             
-            // dequeue the floater and add to list
-            Player floater = upfloaters[0];
-            upfloaters.erase(upfloaters.begin());
-            // recreate lower groups
-            LinkedListNode ng = this->makeNewGroups(*next_group_use, {floater.getID()}, &w_copy, &b_copy);
-            delete next_group_use; // get rid of the old memory
-            next_group_use = new LinkedListNode(ng);
-            
-            // sort new group as necessary
-            if(floater.getDueColor() == Color::WHITE) {
-//                w_copy.push_back(floater);
-                // re-sort white seekers as needed
-                this->sortGroupARO(&w_copy, 0, ((int) w_copy.size()) - 1);
+            if(floaters_tried > 0 && this->splitUpfloaters(g, (int) upfloaters.size())) {
+                // the first floater did not work out, so the lower groups could take a while
+                // try all the floaters left at the same time
+                games = this->pairUpfloaterCandidates(g, upfloaters, white_seekers, black_seekers, pairing_round);
+                upfloaters.clear();
             } else {
-//                b_copy.push_back(floater);
-                // re-sort black seekers as needed
-                Utils::sortPlayersRating(&b_copy, 0, ((int) b_copy.size()) - 1);
+                // dequeue the floater and try it
+                int floater = upfloaters[0];
+                upfloaters.erase(upfloaters.begin());
+                floaters_tried += 1;
+                games = this->pairWithUpfloater(g, floater, white_seekers, black_seekers, pairing_round);
             }
+            
+            if(this->pairing_error) {
+                // try another floater
+                games.clear();
+                this->pairing_error = false;
+                continue;
+            }
+            pair_complete = true;
+            continue;
         }
         
+        // make copies as needed
+        std::vector<int> w_copy = std::vector<int>(white_seekers);
+        std::vector<int> b_copy = std::vector<int>(black_seekers);
         if(pairing_failure_upfloaters) {
             // find the best upfloaters
             bool failure = false;
-            std::set<int> up = this->findMultiUpfloaters(w_copy, b_copy, *next_group_use, failure);
+            this->past_last_group = true;
+            std::set<int> up = this->findMultiUpfloaters(w_copy, b_copy, g + 1, failure);
             
             // check if this doesn't work
             if(failure) {
                 // nothing more can be done
                 this->pairing_error = true;
-                if(next_group_use != nullptr) delete next_group_use;
                 break;
             }
             
             // insert into groups
-            LinkedListNode new_groups = this->makeNewGroups(*next_group_use, up, &w_copy, &b_copy);
-            delete next_group_use;
-            
-            next_group_use = new LinkedListNode(new_groups);
+            this->pullUpfloaters(g + 1, up, &w_copy, &b_copy);
             
             this->sortGroupARO(&w_copy, 0, ((int) w_copy.size()) - 1);
-            Utils::sortPlayersRating(&b_copy, 0, ((int) b_copy.size()) - 1);
+            this->sortGroupRating(&b_copy);
         }
         
         // attempt to pair the groups
         bool error_on_pair = false;
-        std::vector<Match> games_got = this->maximizePairings(w_copy, b_copy, &error_on_pair);
+        std::vector<SlotMatch> games_got = this->maximizePairings(w_copy, b_copy, &error_on_pair);
         
         // check for errors
         if(error_on_pair) {
-            if(floater_required) {
-                // try another floater
-                this->pairing_error = false; // reset as necessary
-                if(next_group_use != nullptr) delete next_group_use;
-                continue;
-            }
             // we must extract the same number of upfloaters as there are in the group
             if(upfloaters.size() == 0) {
                 // make sure that there is a next group
-                if(g->next == nullptr) {
+                if(!has_next) {
                     // nothing more can be done by this point
+                    this->past_last_group = true;
+                    this->pairing_error = true;
+                    break;
+                }
+                // the undo above puts the groups back the same way every time, so findMultiUpfloaters would only pick the same upfloaters again
+                if(pairing_failure_upfloaters) {
                     this->pairing_error = true;
                     break;
                 }
                 pairing_failure_upfloaters = true;
                 this->pairing_error = false;
-                delete next_group_use;
                 continue;
             }
-            if(next_group_use != nullptr) delete next_group_use;
             continue;
         }
         
@@ -2734,31 +2818,29 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makePairingForGro
         
         // try pairing next group lower
 //        std::vector<Match> lower = this->makePairingForGroup(g->next, pairing_round);
-        std::vector<Match> lower = this->makePairingForGroup(next_group_use, pairing_round);
+        std::vector<SlotMatch> lower = this->makePairingForGroup(g + 1, pairing_round);
         
         // check for errors as necessary
         if(this->pairing_error) {
             // clear merged matches
             games.clear();
-            // check if this section required a floater previously
-            if(floater_required) {
-                // we can try another floater, so continue
-                this->pairing_error = false;
-                if(next_group_use != nullptr) delete next_group_use;
-                continue;
-            }
             
 //             we need to extract some floaters to complete the pairing
 //             C.5 states to minimize the number of upfloaters
 //             so gather the next to available upfloaters
             if(upfloaters.empty()) {
-                if(g->next == nullptr) {
+                if(!has_next) {
+                    this->past_last_group = true;
+                    this->pairing_error = true;
+                    break;
+                }
+                // same as above, the lower groups would fail the same way with the same upfloaters
+                if(pairing_failure_upfloaters) {
                     this->pairing_error = true;
                     break;
                 }
                 pairing_failure_upfloaters = true;
                 this->pairing_error = false;
-                delete next_group_use;
                 continue;
             }
             
@@ -2771,7 +2853,6 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makePairingForGro
             if(pairing_failure_upfloaters) {
                 // we can continue as upfloaters are already up
                 this->pairing_error = false;
-                if(next_group_use != nullptr) delete next_group_use;
                 continue;
             }
         }
@@ -2781,33 +2862,345 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makePairingForGro
         
         pair_complete = true; // mark pairing complete
         this->pairing_error = false;
-        
-        delete next_group_use;
     }
     
     // backtrack
-    // put back upfloater as needed
-    if(contains_upfloaters) {
-        g->data.push_back(upfloater);
+    // put back anything pulled if the pairing failed
+    if(!pair_complete) {
+        this->groups.undo(mark);
+    }
+    
+    return games;
+}
+
+std::vector<CPPDubovSystem::SlotMatch> CPPDubovSystem::Tournament::pairWithUpfloater(int g, int floater, std::vector<int> white_seekers, std::vector<int> black_seekers, int pairing_round) {
+    // pull the floater out of the lower groups
+    this->pullUpfloaters(g + 1, {floater}, &white_seekers, &black_seekers);
+    
+    // sort new group as necessary
+    if(this->table->due_color[floater] == Color::WHITE) {
+//        w_copy.push_back(floater);
+        // re-sort white seekers as needed
+        this->sortGroupARO(&white_seekers, 0, ((int) white_seekers.size()) - 1);
+    } else {
+//        b_copy.push_back(floater);
+        // re-sort black seekers as needed
+        this->sortGroupRating(&black_seekers);
+    }
+    
+    // attempt to pair the groups
+    bool error_on_pair = false;
+    std::vector<SlotMatch> games_got = this->maximizePairings(white_seekers, black_seekers, &error_on_pair);
+    if(error_on_pair) {
+        this->pairing_error = true;
+        return std::vector<SlotMatch>();
+    }
+    
+    // try pairing next group lower
+    std::vector<SlotMatch> lower = this->makePairingForGroup(g + 1, pairing_round);
+    if(this->pairing_error) {
+        return std::vector<SlotMatch>();
     }
     
+    // merge
+    std::vector<SlotMatch> games;
+    this->mergeMatches(games_got, &games);
+    this->mergeMatches(lower, &games);
     return games;
 }
 
+bool CPPDubovSystem::Tournament::splitUpfloaters(int g, int candidates) const {
+    // only worth starting threads for when there are plenty of players left to pair below
+    const int min_lower_players = 64;
+    if(candidates < 2 || this->on_worker_thread) {
+        return false;
+    }
+    // a node budget has to count the nodes of every upfloater in order
+    if(this->budget.max_nodes > 0) {
+        return false;
+    }
+    if(this->groups.begin(this->groups.groupCount()) - this->groups.begin(g + 1) < min_lower_players) {
+        return false;
+    }
+    return std::thread::hardware_concurrency() >= 2;
+}
+
+std::vector<CPPDubovSystem::SlotMatch> CPPDubovSystem::Tournament::pairUpfloaterCandidates(int g, const std::vector<int> &floaters, const std::vector<int> &white_seekers, const std::vector<int> &black_seekers, int pairing_round) {
+    int count = (int) floaters.size();
+    int num_threads = (int) std::thread::hardware_concurrency();
+    std::vector<std::vector<SlotMatch>> candidate_games(count);
+    std::vector<char> candidate_ok(count, false);
+    std::vector<char> candidate_past(count, false);
+    std::vector<std::exception_ptr> candidate_exception(count);
+    std::vector<PairingStats> candidate_stats(count, this->stats);
+    std::vector<std::map<std::vector<int>, bool>> candidate_failed(count);
+    std::vector<ScoreGroups> candidate_groups(count);
+    std::vector<std::atomic<bool>> cancelled(count);
+    std::atomic<int> next_candidate(0);
+    auto work = [&]() {
+        // each thread takes the next upfloater nobody has started on yet
+        for(int k = next_candidate++; k < count; k = next_candidate++) {
+            // no need to start on an upfloater after one that already worked
+            if(cancelled[k]) {
+                continue;
+            }
+            try {
+                // the worker shares nothing it writes to with the other threads (it gets its own copy of the groups, scratch arena and failed brackets)
+                Tournament worker(*this);
+                std::pmr::monotonic_buffer_resource candidate_buffer;
+                std::pmr::unsynchronized_pool_resource candidate_arena(&candidate_buffer);
+                worker.scratch = &candidate_arena;
+                worker.on_worker_thread = true;
+                worker.cancelled = &cancelled[k];
+                worker.pairing_error = false;
+                worker.past_last_group = false;
+                candidate_games[k] = worker.pairWithUpfloater(g, floaters[k], white_seekers, black_seekers, pairing_round);
+                candidate_ok[k] = !worker.pairing_error;
+                candidate_past[k] = worker.past_last_group;
+                candidate_stats[k] = worker.stats;
+                candidate_failed[k] = std::move(worker.failed_brackets);
+                if(candidate_ok[k]) {
+                    // the groups are left with this upfloater (and whoever the lower groups pulled) pulled
+                    candidate_groups[k] = std::move(worker.groups);
+                    // nobody after this upfloater is needed any more
+                    for(int z = k + 1; z < count; z++) {
+                        cancelled[z] = true;
+                    }
+                }
+            } catch(...) {
+                candidate_exception[k] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for(int i = 0; i < std::min(num_threads, count); i++) {
+        pool.push_back(std::thread(work));
+    }
+    for(std::thread &t : pool) {
+        t.join();
+    }
+    
+    // take the first upfloater that worked, same as going through them one after the other would
+    int found = -1;
+    for(int k = 0; k < count; k++) {
+        if(candidate_exception[k]) {
+            std::rethrow_exception(candidate_exception[k]);
+        }
+        if(candidate_ok[k]) {
+            found = k;
+            break;
+        }
+    }
+    
+    // keep the counters and the failed brackets of every upfloater which was tried all the way
+    int tried = found == -1 ? count : found + 1;
+    PairingStats before = this->stats;
+    // every upfloater tried is one more attempt at the group, same as in pairGroup (which already counted the first one)
+    this->stats.nodes += tried - 1;
+    for(int k = 0; k < tried; k++) {
+        this->stats.nodes += candidate_stats[k].nodes - before.nodes;
+        this->stats.failed_bracket_hits += candidate_stats[k].failed_bracket_hits - before.failed_bracket_hits;
+        this->stats.out_of_budget = this->stats.out_of_budget || candidate_stats[k].out_of_budget;
+        this->past_last_group = this->past_last_group || candidate_past[k];
+        this->failed_brackets.insert(candidate_failed[k].begin(), candidate_failed[k].end());
+    }
+    
+    if(found == -1) {
+        this->pairing_error = true;
+        return std::vector<SlotMatch>();
+    }
+    this->groups = std::move(candidate_groups[found]);
+    return candidate_games[found];
+}
+
+std::vector<CPPDubovSystem::SlotMatch> CPPDubovSystem::Tournament::pairSegments(int pairing_round) {
+    // smaller rounds are paired quickly enough that starting threads is not worth it
+    const int min_players = 256;
+    int group_count = this->groups.groupCount();
+    int num_players = this->groups.begin(group_count);
+    int num_threads = (int) std::thread::hardware_concurrency();
+    if(num_players < min_players || num_threads < 2 || group_count < 2) {
+        return this->makePairingForGroup(0, pairing_round);
+    }
+    // a node budget has to count the nodes of the whole round in order, and segments would each spend the budget on their own
+    if(this->budget.max_nodes > 0) {
+        return this->makePairingForGroup(0, pairing_round);
+    }
+    
+    // cut the groups into about one segment per thread
+    // a cut only goes where the players above it add up to an even number, so no upfloater is needed across it just to make the numbers work
+    std::vector<int> cuts = {0};
+    int target = num_players / num_threads;
+    for(int g = 0; g + 1 < group_count; g++) {
+        int above = this->groups.end(g);
+        if(above % 2 == 0 && above - this->groups.begin(cuts.back()) >= target) {
+            cuts.push_back(g + 1);
+        }
+    }
+    cuts.push_back(group_count);
+    int num_segments = ((int) cuts.size()) - 1;
+    if(num_segments < 2) {
+        return this->makePairingForGroup(0, pairing_round);
+    }
+    
+    // pair each segment as if it were the whole round
+    std::vector<std::vector<SlotMatch>> segment_games(num_segments);
+    std::vector<char> segment_ok(num_segments, false);
+    std::vector<PairingStats> segment_stats(num_segments, this->stats);
+    std::atomic<int> next_segment(0);
+    auto work = [&]() {
+        // each thread takes the next segment nobody has started on yet
+        for(int k = next_segment++; k < num_segments; k = next_segment++) {
+            try {
+                // the worker shares nothing it writes to with the other threads (it gets its own groups, scratch arena and warm start)
+                Tournament worker(*this);
+                std::pmr::monotonic_buffer_resource segment_buffer;
+                std::pmr::unsynchronized_pool_resource segment_arena(&segment_buffer);
+                worker.scratch = &segment_arena;
+                worker.on_worker_thread = true;
+                worker.groups = this->groups.segment(cuts[k], cuts[k + 1]);
+                worker.pairing_error = false;
+                worker.past_last_group = false;
+                // the segment ends before the last group, so the brackets failed so far mean something else to it
+                worker.failed_brackets.clear();
+                segment_games[k] = worker.makePairingForGroup(0, pairing_round);
+                segment_stats[k] = worker.stats;
+                // nothing is below the last segment, so it is fine for it to go looking past its last group
+                segment_ok[k] = !worker.pairing_error && (!worker.past_last_group || k == num_segments - 1);
+            } catch(...) {
+                // pairing the groups one after the other will run into the same problem and report it
+                segment_ok[k] = false;
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for(int i = 0; i < std::min(num_threads, num_segments); i++) {
+        pool.push_back(std::thread(work));
+    }
+    for(std::thread &t : pool) {
+        t.join();
+    }
+    
+    // add up the search done by every segment (each one started from the counters as they were)
+    PairingStats before = this->stats;
+    for(int k = 0; k < num_segments; k++) {
+        this->stats.nodes += segment_stats[k].nodes - before.nodes;
+        this->stats.failed_bracket_hits += segment_stats[k].failed_bracket_hits - before.failed_bracket_hits;
+        this->stats.out_of_budget = this->stats.out_of_budget || segment_stats[k].out_of_budget;
+    }
+    
+    // check that every segment could be paired on its own
+    for(int k = 0; k < num_segments; k++) {
+        if(!segment_ok[k]) {
+            // some segment depends on the groups below it, so pair everything together
+            return this->makePairingForGroup(0, pairing_round);
+        }
+    }
+    
+    // merge the segments in group order, which is the same order pairing the groups one after the other gives
+    std::vector<SlotMatch> games;
+    for(int k = 0; k < num_segments; k++) {
+        this->mergeMatches(segment_games[k], &games);
+    }
+    
+    return games;
+}
+
+int CPPDubovSystem::Tournament::pairByeCandidates(const std::vector<int> &bye_slots, int pairing_round, std::vector<SlotMatch> *games) {
+    int count = (int) bye_slots.size();
+    std::vector<std::vector<SlotMatch>> candidate_games(count);
+    std::vector<char> candidate_ok(count, false);
+    std::vector<std::exception_ptr> candidate_exception(count);
+    std::vector<PairingStats> candidate_stats(count, this->stats);
+    std::vector<std::map<std::vector<int>, bool>> candidate_failed(count);
+    std::vector<std::atomic<bool>> cancelled(count);
+    
+    // pair the round once for every bye player
+    auto work = [&](int k) {
+        try {
+            // the worker shares nothing it writes to with the other threads (it gets its own groups, scratch arena and failed brackets, and only reads the player table and compatibility matrix it shares)
+            Tournament worker(*this);
+            std::pmr::monotonic_buffer_resource candidate_buffer;
+            std::pmr::unsynchronized_pool_resource candidate_arena(&candidate_buffer);
+            worker.scratch = &candidate_arena;
+            worker.on_worker_thread = true;
+            worker.cancelled = &cancelled[k];
+            worker.current_bye = bye_slots[k];
+            worker.groups = worker.makeGroups(bye_slots[k]);
+            worker.pairing_error = false;
+            // this thread is already one of many, so the groups are paired one after the other
+            candidate_games[k] = worker.makePairingForGroup(0, pairing_round);
+            candidate_ok[k] = !worker.pairing_error;
+            candidate_stats[k] = worker.stats;
+            candidate_failed[k] = std::move(worker.failed_brackets);
+            if(candidate_ok[k]) {
+                // nobody after this bye player is needed any more
+                for(int z = k + 1; z < count; z++) {
+                    cancelled[z] = true;
+                }
+            }
+        } catch(...) {
+            candidate_exception[k] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> pool;
+    for(int k = 0; k < count; k++) {
+        pool.push_back(std::thread(work, k));
+    }
+    for(std::thread &t : pool) {
+        t.join();
+    }
+    
+    // take the first bye player that worked, same as going through them one after the other would
+    int found = -1;
+    for(int k = 0; k < count; k++) {
+        if(candidate_exception[k]) {
+            std::rethrow_exception(candidate_exception[k]);
+        }
+        if(candidate_ok[k]) {
+            found = k;
+            break;
+        }
+    }
+    
+    // keep the counters and the failed brackets of every bye player which was tried all the way (the ones before the bye player that worked)
+    int tried = found == -1 ? count : found + 1;
+    PairingStats before = this->stats;
+    for(int k = 0; k < tried; k++) {
+        this->stats.nodes += candidate_stats[k].nodes - before.nodes;
+        this->stats.failed_bracket_hits += candidate_stats[k].failed_bracket_hits - before.failed_bracket_hits;
+        this->stats.out_of_budget = this->stats.out_of_budget || candidate_stats[k].out_of_budget;
+        if(k != found) {
+            this->failed_brackets.insert(candidate_failed[k].begin(), candidate_failed[k].end());
+        }
+    }
+    this->stats.byes_tried += tried;
+    
+    if(found != -1) {
+        *games = std::move(candidate_games[found]);
+    }
+    return found;
+}
+
 std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makeSubsequent(int pairing_round) {
     std::vector<Match> games;
-    // sort players
-    Utils::sortPlayersRating(&this->players, 0, this->player_count - 1);
-    this->sortPlayersPoints(&this->players, 0, this->player_count - 1);
+    // initialize due colors for players
+    this->initPlayers();
+    
+    // rank players
+    this->rankPlayers();
+    
+    // nobody has been matched yet this round
+    this->warm_mate.assign(this->table->id.size(), -1);
+    this->warm_vertex.assign(this->table->id.size(), -1);
+    this->failed_brackets.clear();
+    this->current_bye = -1;
     
     // handle byes as necessary
     if(((int) this->players.size()) % 2 > 0) {
-        this->bye_queue = this->getByePlayerStack(this->players, pairing_round);
+        this->bye_queue = this->getByePlayerStack(this->ranking, pairing_round);
     }
     
-    // initialize due colors for players
-    this->initPlayers();
-    
     // make groups
 //    LinkedList groups = this->makeGroups();
     
@@ -2816,35 +3209,60 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makeSubsequent(in
     
     if(this->bye_queue.size() > 0) {
         // since just about anybody can get a bye, we need to constantly keep trying to give different players the bye until we get a valid set of pairings
-        LinkedList groups;
-        LinkedListNode* curr = nullptr; // just a temporary value
+        int num_threads = (int) std::thread::hardware_concurrency();
         while(this->bye_queue.size() > 0) {
-            // remove bye player
-            Player p_bye;
-            int bye_p = this->removeByePlayer(&this->players, this->bye_queue[0], &p_bye);
-            this->bye_queue.erase(this->bye_queue.begin());
-            this->player_count -= 1;
-            groups = this->makeGroups();
-            curr = groups.getHead();
-            games = this->makePairingForGroup(curr, pairing_round);
-            
-            // put bye player back
-            this->players.insert(std::next(this->players.begin(), bye_p), p_bye);
-            this->player_count += 1;
-            
-            // check for errors
-            if(this->pairing_error) {
-                // put bye player back and try dequeing another bye player
-                this->pairing_error = false;
-                games.clear();
-                continue;
+            int bye_slot = -1;
+            std::vector<SlotMatch> slot_games;
+            // a node budget has to count the nodes of every bye player in order, so those searches stay one after the other
+            if(this->stats.byes_tried > 0 && num_threads >= 2 && this->bye_queue.size() >= 2 && this->budget.max_nodes <= 0) {
+                // the first bye player did not work out, so the search could take a while
+                // try the next few bye players at the same time, keeping the first one (in queue order) that works
+                std::vector<int> batch;
+                while(((int) batch.size()) < num_threads && this->bye_queue.size() > 0) {
+                    int s = this->findSlot(this->bye_queue[0]);
+                    ASSERT(s != -1, "The bye player is not in the tournament. This is a bug and should be unlikely to happen");
+                    this->bye_queue.erase(this->bye_queue.begin());
+                    batch.push_back(s);
+                }
+                int found = this->pairByeCandidates(batch, pairing_round, &slot_games);
+                if(found == -1) {
+                    // no other bye player gets a chance once the search is out of budget
+                    if(this->stats.out_of_budget) {
+                        break;
+                    }
+                    continue;
+                }
+                bye_slot = batch[found];
+                this->current_bye = bye_slot;
+            } else {
+                // leave the bye player out of the groups
+                bye_slot = this->findSlot(this->bye_queue[0]);
+                ASSERT(bye_slot != -1, "The bye player is not in the tournament. This is a bug and should be unlikely to happen");
+                this->bye_queue.erase(this->bye_queue.begin());
+                this->current_bye = bye_slot;
+                this->stats.byes_tried += 1;
+                this->groups = this->makeGroups(bye_slot);
+                slot_games = this->pairSegments(pairing_round);
+                
+                // check for errors
+                if(this->pairing_error) {
+                    // no other bye player gets a chance once the search is out of budget
+                    if(this->stats.out_of_budget) {
+                        break;
+                    }
+                    // try dequeing another bye player
+                    this->pairing_error = false;
+                    continue;
+                }
             }
             
+            games = this->makeMatches(slot_games);
+            
             // assert we have the right number of pairs
             ASSERT(((int) games.size()) == (((int) this->players.size()) / 2), "Improper number of games created!");
             
             // we must have had success
-            games.push_back(Match(p_bye, Player("", 0, -1, 0.0), true));
+            games.push_back(Match(this->player(bye_slot), Player("", 0, -1, 0.0, *this->names), true));
             // clear bye queue
             this->bye_queue.clear();
             // assert that we have the right numbers of pairs
@@ -2857,9 +3275,289 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makeSubsequent(in
             this->pairing_error = true;
         }
     } else {
-        LinkedList groups = this->makeGroups();
-        LinkedListNode *curr = groups.getHead();
-        games = this->makePairingForGroup(curr, pairing_round);
+        this->groups = this->makeGroups();
+        games = this->makeMatches(this->pairSegments(pairing_round));
+    }
+    
+    return games;
+}
+
+std::vector<CPPDubovSystem::SlotMatch> CPPDubovSystem::Tournament::pairGlobally(int bye_slot) {
+    ScoreGroups all = this->makeGroups(bye_slot);
+    
+    // group[s] is the score group of each slot, and order[s] is where the player stands among the seekers of the same color in that group
+    // white seekers go by ARO and black seekers by rating, so pairing the i-th white seeker with the i-th black seeker is the order the group engine starts from
+    // pick[s] is where the player stands in the group by pairing number, which is the order the group engine tries upfloaters in
+    int slot_count = (int) this->table->id.size();
+    std::vector<int> group(slot_count, -1);
+    std::vector<int> order(slot_count, 0);
+    std::vector<int> pick(slot_count, 0);
+    std::vector<int> vertex_slot;
+    // the white seekers and black seekers of each group in the order above
+    std::vector<std::vector<int>> white_of(all.groupCount());
+    std::vector<std::vector<int>> black_of(all.groupCount());
+    // the sort keys of the white seekers and black seekers of each group, to find where an upfloater would be sorted in
+    auto white_key = [this](int s) {
+        return (((std::uint64_t) Utils::orderedKey((int) this->table->aro[s])) << 32) | Utils::orderedKey(this->table->id[s]);
+    };
+    auto black_key = [this](int s) {
+        return (std::uint64_t) Utils::orderedKey(this->table->id[s]);
+    };
+    std::vector<std::vector<std::uint64_t>> white_keys(all.groupCount());
+    std::vector<std::vector<std::uint64_t>> black_keys(all.groupCount());
+    int max_order = 0;
+    int max_group = 0;
+    for(int g = 0; g < all.groupCount(); g++) {
+        std::vector<int> members = all.members(g);
+        std::vector<int> ws;
+        std::vector<int> bs;
+        this->splitGroups(&ws, &bs, members);
+        this->sortGroupARO(&ws, 0, ((int) ws.size()) - 1);
+        this->sortGroupRating(&bs);
+        for(int i = 0; i < ws.size(); i++) {
+            group[ws[i]] = g;
+            order[ws[i]] = i;
+            white_keys[g].push_back(white_key(ws[i]));
+        }
+        for(int i = 0; i < bs.size(); i++) {
+            group[bs[i]] = g;
+            order[bs[i]] = i;
+            black_keys[g].push_back(black_key(bs[i]));
+        }
+        for(int i = 0; i < members.size(); i++) {
+            pick[members[i]] = i;
+            vertex_slot.push_back(members[i]);
+        }
+        max_order = std::max(max_order, (int) std::max(ws.size(), bs.size()));
+        max_group = std::max(max_group, (int) members.size());
+        white_of[g] = ws;
+        black_of[g] = bs;
+    }
+    // upfloat restrictions don't count in the last round
+    bool last_round = this->current_round == this->total_rounds;
+    
+    if(vertex_slot.size() < 2) return std::vector<SlotMatch>();
+    
+    // every criterion gets its own range of the cost, and each range is bigger than anything the criteria below it can add up to over the whole round
+    // that way the matching only gives in on a criterion to do better on a more important one
+    long long pairs = ((long long) vertex_slot.size()) / 2;
+    long long max_diff = this->table->score[vertex_slot.front()] - this->table->score[vertex_slot.back()];
+    long long r_up = pairs + 1;
+    long long r_rule = pairs + 1;
+    long long r_color = pairs + 1;
+    // leave plenty of room for the solver, which doubles the costs and adds them up
+    long double budget = (long double) (LLONG_MAX / 8);
+    long double upper = ((long double) (pairs * max_diff * max_diff + 1)) * r_up * r_rule * r_color;
+    if(upper > budget) {
+        // too many players for the costs to fit, so this engine can't pair the round
+        this->pairing_error = true;
+        return std::vector<SlotMatch>();
+    }
+    // the order is only a tie break, so it is capped to whatever room is left (only very large rounds ever reach the cap)
+    long long order_room = (long long) (budget / upper);
+    long long place_cap = std::min((order_room - 1) / pairs, ((long long) max_group + 1) * (max_order + 1));
+    long long r_order = pairs * place_cap + 1;
+    
+    // how far an upfloater is sorted in from its opponent only counts up to this many places, so where it was picked from its group counts first
+    const int window = 16;
+    // the cost of the game between the players at i and z (i < z), or -1 if they can't play each other
+    auto game_cost = [&](int i, int z) -> long long {
+        int a = vertex_slot[i];
+        int b = vertex_slot[z];
+        if(!this->canPlay(a, b)) return -1;
+        
+        // a is always ranked at least as high as b, so b is the one floating up
+        // the score difference is squared, so several upfloaters from the next group are better than one from far below (the group engine pairs group by group)
+        long long diff = this->table->score[a] - this->table->score[b];
+        long long spread = diff * diff;
+        long long upfloat = group[a] != group[b] ? 1 : 0;
+        long long rule = upfloat && !last_round && (this->table->upfloated_prev[b] || !this->table->canUpfloat(b, this->total_rounds)) ? 1 : 0;
+        long long color = this->table->due_color[a] == this->table->due_color[b] && this->table->due_color[a] != Color::NO_COLOR ? 1 : 0;
+        long long place = place_cap;
+        if(upfloat) {
+            // take the upfloaters in the order of their group first, and then pair them as if they were sorted into the higher group
+            const std::vector<std::uint64_t> &keys = this->table->due_color[b] == Color::WHITE ? white_keys[group[a]] : black_keys[group[a]];
+            std::uint64_t key = this->table->due_color[b] == Color::WHITE ? white_key(b) : black_key(b);
+            int sorted_in = (int) (std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+            place = ((long long) pick[b]) * (window + 1) + std::min(std::abs(order[a] - sorted_in), window);
+        } else if(!color) {
+            // same group, so the white seekers and black seekers should meet in order
+            place = std::abs(order[a] - order[b]);
+        }
+        
+        return (((spread * r_up + upfloat) * r_rule + rule) * r_color + color) * r_order + std::min(place, place_cap);
+    };
+    
+    // with every game that is allowed in the graph, big rounds take far too long to solve
+    // so the matching is solved on the games most likely to be played first: players close to each other in the ranking (which takes in the top and bottom of the next groups) and the white and black seekers of a group in about the same order
+    // the duals of that matching then show if any game left out could make it cheaper, and those are added and the matching solved again until none can
+    // that gives the same minimum as solving with every game in the graph
+    int count = (int) vertex_slot.size();
+    std::vector<int> vertex_of(slot_count, -1);
+    for(int i = 0; i < count; i++) {
+        vertex_of[vertex_slot[i]] = i;
+    }
+    std::vector<std::pair<int, int>> edges;
+    std::vector<long long> cost;
+    std::vector<char> in_graph(((size_t) count) * count, false);
+    auto add_game = [&](int i, int z) {
+        if(i > z) std::swap(i, z);
+        if(i == z || in_graph[((size_t) i) * count + z]) return;
+        long long c = game_cost(i, z);
+        if(c < 0) return;
+        in_graph[((size_t) i) * count + z] = true;
+        edges.push_back(std::make_pair(i, z));
+        cost.push_back(c);
+    };
+    // every player gets the games with the players up to reach places below them
+    int reach = 0;
+    auto widen = [&](int new_reach) {
+        for(int i = 0; i < count; i++) {
+            for(int z = i + reach + 1; z <= std::min(count - 1, i + new_reach); z++) {
+                add_game(i, z);
+            }
+        }
+        reach = new_reach;
+    };
+    widen(std::min(count - 1, window));
+    for(int g = 0; g < all.groupCount(); g++) {
+        for(int i = 0; i < white_of[g].size(); i++) {
+            for(int z = std::max(0, i - 1); z <= std::min((int) black_of[g].size() - 1, i + 1); z++) {
+                add_game(vertex_of[white_of[g][i]], vertex_of[black_of[g][z]]);
+            }
+        }
+    }
+    
+    // the games of the last matching found, which pairs everybody even if a cheaper matching might be found
+    std::vector<std::pair<int, int>> boards;
+    // this is what runs once the score groups engine is out of budget, so it has to come up with a pairing: the first matching is always solved all the way
+    // after that the clock (and only the clock, the node budget is for the score groups) can cut the search for a cheaper one short
+    auto stop = [this, &boards]() {
+        return !boards.empty() && this->outOfTime();
+    };
+    while(true) {
+        Graph g(count);
+        for(const std::pair<int, int> &e : edges) {
+            g.AddEdge(e.first, e.second);
+        }
+        
+        // the games left out which the duals of the matching found say could make it cheaper
+        std::vector<std::pair<int, int>> missing;
+        auto check = [&](const auto &solver) {
+            for(int i = 0; i < count; i++) {
+                for(int z = i + 1; z < count; z++) {
+                    if(in_graph[((size_t) i) * count + z]) continue;
+                    long long c = game_cost(i, z);
+                    if(c >= 0 && !solver.IsDualFeasible(i, z, c)) {
+                        missing.push_back(std::make_pair(i, z));
+                    }
+                }
+            }
+        };
+        std::pair<std::vector<int>, long long> matched;
+        std::vector<int> side;
+        if(BipartiteMatching<long long>::IsBipartite(g, side)) {
+            if(((int) BipartiteMatching<long long>::SolveMaximumMatching(g, side).size()) * 2 == g.GetNumVertices()) {
+                BipartiteMatching<long long> bm(g, side);
+                bm.SetStop(stop);
+                matched = bm.SolveMinimumCostPerfectMatching(cost);
+                if(!matched.first.empty()) check(bm);
+            }
+        } else {
+            Matching<long long> matching(g);
+            matching.SetStop(stop);
+            matched = matching.SolveMinimumCostPerfectMatching(cost);
+            if(!matched.first.empty()) check(matching);
+        }
+        
+        if(matched.first.empty()) {
+            // the solver gave up on the clock, so the last matching found is the best there is
+            if(!boards.empty()) {
+                break;
+            }
+            // with every game in the graph, the players really can't all be paired
+            if(reach >= count - 1) {
+                return std::vector<SlotMatch>();
+            }
+            // otherwise there were too few games to pair everybody, so take in more
+            widen(std::min(count - 1, reach * 2));
+            continue;
+        }
+        
+        boards.clear();
+        for(int e : matched.first) {
+            std::pair<int, int> ends;
+            if(g.TryGetEdge(e, ends) != GRAPH_OK) {
+                // the matching gave an edge that is not in the graph, which is a bug in the solver
+                this->pairing_error = true;
+                return std::vector<SlotMatch>();
+            }
+            boards.push_back(std::make_pair(std::min(ends.first, ends.second), std::max(ends.first, ends.second)));
+        }
+        if(missing.empty() || this->outOfTime()) {
+            break;
+        }
+        for(const std::pair<int, int> &game : missing) {
+            add_game(game.first, game.second);
+        }
+    }
+    
+    // list the games from the top board down, and give white to whoever is due white (the higher ranked player if neither is)
+    std::sort(boards.begin(), boards.end());
+    
+    std::vector<SlotMatch> games;
+    for(auto board : boards) {
+        int a = vertex_slot[board.first];
+        int b = vertex_slot[board.second];
+        if(this->table->due_color[a] != Color::WHITE && this->table->due_color[b] == Color::WHITE) {
+            games.push_back(SlotMatch(b, a));
+        } else {
+            games.push_back(SlotMatch(a, b));
+        }
+    }
+    
+    // settle who gets their due color when both players are due the same one
+    this->optimizeColors(&games);
+    
+    return games;
+}
+
+std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::makeGlobalSubsequent(int pairing_round) {
+    std::vector<Match> games;
+    this->initPlayers();
+    this->rankPlayers();
+    
+    if(((int) this->players.size()) % 2 == 0) {
+        std::vector<SlotMatch> slot_games = this->pairGlobally(-1);
+        if(slot_games.empty() || this->pairing_error) {
+            this->pairing_error = true;
+            return games;
+        }
+        return this->makeMatches(slot_games);
+    }
+    
+    // try the bye candidates in the same order as the group engine, until the rest of the players can be paired
+    this->bye_queue = this->getByePlayerStack(this->ranking, pairing_round);
+    while(this->bye_queue.size() > 0) {
+        int bye_slot = this->findSlot(this->bye_queue[0]);
+        ASSERT(bye_slot != -1, "The bye player is not in the tournament. This is a bug and should be unlikely to happen");
+        this->bye_queue.erase(this->bye_queue.begin());
+        
+        std::vector<SlotMatch> slot_games = this->pairGlobally(bye_slot);
+        // the round is too big for this engine no matter who gets the bye
+        if(this->pairing_error) {
+            return std::vector<Match>();
+        }
+        if(slot_games.empty()) continue;
+        
+        games = this->makeMatches(slot_games);
+        games.push_back(Match(this->player(bye_slot), Player("", 0, -1, 0.0, *this->names), true));
+        this->bye_queue.clear();
+        break;
+    }
+    
+    if(games.size() == 0) {
+        this->pairing_error = true;
     }
     
     return games;
@@ -2893,6 +3591,21 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::fixBakuR1(const s
 }
 
 std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::generatePairings(int r) {
+    return this->generatePairings(r, PairingEngine::SCORE_GROUPS);
+}
+
+std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::generatePairings(int r, PairingEngine engine) {
+    return this->generatePairings(r, engine, PairingBudget());
+}
+
+std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::generatePairings(int r, PairingEngine engine, const PairingBudget &budget) {
+    // start the clock and the counters for this round
+    this->budget = budget;
+    this->stats = PairingStats();
+    this->search_start = std::chrono::steady_clock::now();
+    this->deadline = budget.max_seconds;
+    // the score groups engine only gets part of the time, so there is always time left to fall back on the global matching engine
+    const double search_share = 0.5;
     int max_rounds = getPlayerCount() % 2 == 0 ? getPlayerCount() - 1 : getPlayerCount();
     if (max_rounds < 1) max_rounds = 1;
     if (max_rounds < this->total_rounds){
@@ -2903,14 +3616,41 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::generatePairings(
             return this->makeRound1();
         }
         this->current_round = r;
-        return this->makeSubsequent(r);
+        // all the scratch containers of the pairing engine come out of this round's arena, and everything is released at once when the round is done
+        // the pool hands freed blocks back out again, so memory stays bounded even when the round backtracks a lot
+        std::pmr::monotonic_buffer_resource round_buffer;
+        std::pmr::unsynchronized_pool_resource round_arena(&round_buffer);
+        this->scratch = &round_arena;
+        std::vector<Match> games;
+        try {
+            if(engine == PairingEngine::GLOBAL_MATCHING) {
+                games = this->makeGlobalSubsequent(r);
+            } else {
+                this->deadline = budget.max_seconds * search_share;
+                games = this->makeSubsequent(r);
+                if(this->stats.out_of_budget) {
+                    // the search was cut short before it found anything, so fall back on the global matching engine, which takes polynomial time
+                    // it gets the rest of the time to look for the cheapest pairing, but always comes up with one if the players can be paired at all
+                    this->pairing_error = false;
+                    this->deadline = budget.max_seconds;
+                    games = this->makeGlobalSubsequent(r);
+                }
+            }
+        } catch(...) {
+            this->scratch = std::pmr::get_default_resource();
+            throw;
+        }
+        this->scratch = std::pmr::get_default_resource();
+        this->stats.failed_brackets = (long long) this->failed_brackets.size();
+        this->stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->search_start).count();
+        return games;
     }
 }
 
-std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::generatePairings(int r, bool baku_acceleration) {
+std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::generatePairings(int r, bool baku_acceleration, PairingEngine engine, const PairingBudget &budget) {
     if(!baku_acceleration) {
         // do normal pairings
-        return this->generatePairings(r);
+        return this->generatePairings(r, engine, budget);
     }
     // first sort all players properly
     Utils::sortPlayersRating(&this->players, 0, ((int) this->players.size()) - 1);
@@ -2926,10 +3666,10 @@ std::vector<CPPDubovSystem::Match> CPPDubovSystem::Tournament::generatePairings(
     // apply pairings
     std::vector<Match> m;
     if(r == 1) {
-        m = this->generatePairings(0);
+        m = this->generatePairings(0, engine, budget);
         m = this->fixBakuR1(m);
     } else {
-        m = this->generatePairings(r);
+        m = this->generatePairings(r, engine, budget);
     }
     
     return m;
@@ -2994,7 +3734,7 @@ CPPDubovSystem::Tournament CPPDubovSystem::Tournament::makeTournament(const TRFU
         opp_ratings[id] = rating;
         
 //        Player p_add(name, rating, id, points);
-        p_add = new Player(name, rating, id, points);
+        p_add = new Player(name, rating, id, points, *t_main.names);
         
         // render results
         for(int z = 1; z <= from_data.getRounds(); z++) {
@@ -3183,6 +3923,9 @@ CPPDubovSystem::Tournament CPPDubovSystem::Tournament::makeTournament(const TRFU
     
     Utils::sortRawMatches(&match_eval, 0, ((int) match_eval.size()) - 1);
     
+    // points each player has according to the trf, by position in players_list
+    std::vector<double> trf_pts(players_list.size(), 0.0);
+    
     // set up floats
     for(int i = 0; i < match_eval.size(); i++) {
         // check if we are skipping
@@ -3198,7 +3941,7 @@ CPPDubovSystem::Tournament CPPDubovSystem::Tournament::makeTournament(const TRFU
 //            }
             int wib = match_eval[i].getWID();
             int wbw = player_pos[wib];
-            players_list[wbw].trf_pts += match_eval[i].white_pts;
+            trf_pts[wbw] += match_eval[i].white_pts;
             continue;
         }
         int wi = match_eval[i].getWID();
@@ -3213,15 +3956,15 @@ CPPDubovSystem::Tournament CPPDubovSystem::Tournament::makeTournament(const TRFU
         // adjust floats
         // anybody with a forfeit doesn't count for a float because the game wasn't played!
         //TODO: WHAT ABOUT PLAYERS WITH A FORFEIT LOSS? IF THEY PLAYED SOMEONE WITH A HIGHER SCORE AND GOT A FORFEIT LOSS, DO THEY STILL GET MARKED AS AN UPFLOATER EVEN THOUGH THE GAME WAS NEVER PLAYED?
-        if(players_list[w].trf_pts > players_list[b].trf_pts && !forfeit_hash.contains(mh)) {
+        if(trf_pts[w] > trf_pts[b] && !forfeit_hash.contains(mh)) {
             players_list[b].incrementUpfloat();
             players_list[b].setUpfloatPrevStatus(true);
-        } else if(players_list[w].trf_pts < players_list[b].trf_pts && !forfeit_hash.contains(mh)) {
+        } else if(trf_pts[w] < trf_pts[b] && !forfeit_hash.contains(mh)) {
             players_list[w].incrementUpfloat();
             players_list[w].setUpfloatPrevStatus(true);
         }
-        players_list[w].trf_pts += match_eval[i].white_pts;
-        players_list[b].trf_pts += match_eval[i].black_pts;
+        trf_pts[w] += match_eval[i].white_pts;
+        trf_pts[b] += match_eval[i].black_pts;
     }
     
     // prepare all pairing restrictions to add
@@ -3258,7 +4001,7 @@ CPPDubovSystem::Tournament CPPDubovSystem::Tournament::makeTournament(const TRFU
         // set players points to trf points if stop_read > -1
         if(stop_read > -1) {
             double pt = players_list[i].getPoints();
-            double trfpt = players_list[i].trf_pts;
+            double trfpt = trf_pts[i];
             double add = trfpt - pt;
             players_list[i].addPoints(add);
         }
@@ -27,15 +27,23 @@
 #endif
 
 #include <stdio.h>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
 #include <queue>
+#include <set>
 #include <vector>
 #include <memory>
 #include "Player.hpp"
-#include "LinkedList.hpp"
+#include "ScoreGroups.hpp"
 #include "trf util/trf.hpp"
 #include "trf util/rtg.hpp"
 #include "baku.hpp"
 #include "graph util/Matching.h"
+#include "graph util/BipartiteMatching.h"
 
 
 /**
@@ -65,10 +73,29 @@ public:
     Match(const Player &white, const Player &black, bool is_bye);
 };
 
+/**
+ * A match between two player slots. The pairing engine only passes these around, and they are turned into a Match once the round has been paired
+ */
+class SlotMatch {
+public:
+    /**
+     * Slot of the player playing white in the match
+     */
+    int white;
+    /**
+     * Slot of the player playing black in the match
+     */
+    int black;
+    /**
+     * Constructor for both slots
+     */
+    SlotMatch(int white, int black);
+};
+
 /**
  * For evaluating matches
  */
-class MatchEval: public Match {
+class MatchEval: public SlotMatch {
 private:
     /**
      * If this match has a problem. In other words, the players cannot play each other for whatever reason (for instance they already played each other in the tournament before).
@@ -76,9 +103,9 @@ private:
     bool problem;
 public:
     /**
-     * Constructs the match evaluation with a given white player, black player, and a boolean indicating if there is a problem in the match
+     * Constructs the match evaluation with a given white player slot, black player slot, and a boolean indicating if there is a problem in the match
      */
-    MatchEval(const Player &white, const Player &black, bool problem);
+    MatchEval(int white, int black, bool problem);
     
     /**
      * Sets the problem
@@ -95,13 +122,74 @@ public:
  */
 namespace Utils {
 /**
- * For merge sort (sorting players by rating)
+ * Maps an int to an unsigned sort key, so that comparing the keys gives the same order as comparing the ints
  */
-void playersRatingMerge(std::vector<Player> *players, int const left, int const mid, int const right);
+inline std::uint32_t orderedKey(int v) {return ((std::uint32_t) v) ^ 0x80000000u;}
 /**
- * For merge sort (sorting players by rating in rtg)
+ * Maps a double to an unsigned sort key, so that comparing the keys gives the same order as comparing the doubles
  */
-void playersRatingRTGMerge(std::vector<Player> *players, int const left, int const mid, int const right);
+inline std::uint64_t orderedKey(double v) {
+    std::uint64_t bits = std::bit_cast<std::uint64_t>(v + 0.0); // adding 0.0 turns -0.0 into 0.0
+    return (bits >> 63) ? ~bits : bits | (std::uint64_t(1) << 63);
+}
+/**
+ * Sorts the items between begin and end (both included) by a 64-bit key, smallest key first.
+ * This is an LSD radix sort on (key, index) pairs, so items with equal keys keep their order. Only the pairs move between the radix passes, and each item is then moved twice (into a sorted copy and back)
+ */
+template<typename T, typename KeyOf>
+void sortByKey(std::vector<T> *items, int const begin, int const end, KeyOf key_of) {
+    int n = end - begin + 1;
+    if(n < 2) return;
+    
+    std::vector<std::pair<std::uint64_t, int>> keyed(n);
+    std::uint64_t all_or = 0;
+    std::uint64_t all_and = ~std::uint64_t(0);
+    for(int i = 0; i < n; i++) {
+        keyed[i] = std::make_pair((std::uint64_t) key_of((*items)[begin + i]), i);
+        all_or |= keyed[i].first;
+        all_and &= keyed[i].first;
+    }
+    
+    if(n <= 32) {
+        // small ranges are faster with a plain insertion sort
+        for(int i = 1; i < n; i++) {
+            std::pair<std::uint64_t, int> k = keyed[i];
+            int z = i - 1;
+            while(z >= 0 && keyed[z].first > k.first) {
+                keyed[z + 1] = keyed[z];
+                z -= 1;
+            }
+            keyed[z + 1] = k;
+        }
+    } else {
+        // one counting pass per byte, skipping the bytes that are the same in every key
+        std::vector<std::pair<std::uint64_t, int>> buffer(n);
+        for(int shift = 0; shift < 64; shift += 8) {
+            if((((all_or ^ all_and) >> shift) & 0xff) == 0) continue;
+            int count[257] = {0};
+            for(int i = 0; i < n; i++) {
+                count[((keyed[i].first >> shift) & 0xff) + 1] += 1;
+            }
+            for(int i = 0; i < 256; i++) {
+                count[i + 1] += count[i];
+            }
+            for(int i = 0; i < n; i++) {
+                buffer[count[(keyed[i].first >> shift) & 0xff]++] = keyed[i];
+            }
+            keyed.swap(buffer);
+        }
+    }
+    
+    // now move the items into place
+    std::vector<T> sorted;
+    sorted.reserve(n);
+    for(int i = 0; i < n; i++) {
+        sorted.push_back(std::move((*items)[begin + keyed[i].second]));
+    }
+    for(int i = 0; i < n; i++) {
+        (*items)[begin + i] = std::move(sorted[i]);
+    }
+}
 /**
  * For sorting players by rating
  */
@@ -173,13 +261,13 @@ public:
     int getTargetRound() const {return target_round;}
     
     /**
-     * Distributes the point information to the players
+     * Distributes the point information to the trf points of the players (keyed by player id)
      */
-    void distributePoints();
+    void distributePoints(std::map<int, double> &trf_pts) const;
     /**
-     * Distributes float info to the players
+     * Distributes float info to the players, using the trf points of the players (keyed by player id)
      */
-    void distributeFloat();
+    void distributeFloat(std::map<int, double> &trf_pts);
     
     /**
      * Gets the ID of white player
@@ -190,16 +278,129 @@ public:
      */
     int getBID() const;
 };
-/**
- * For merge sort. Sorts the raw matches
- */
-void mergeRawMatches(std::vector<Utils::TRFMatch> *raw_games, int const left, int const mid, int const right);
 /**
  * Sorts the raw TRF matches by round
  */
 void sortRawMatches(std::vector<Utils::TRFMatch> *raw_games, const int begin, const int end);
 }
 
+/**
+ * The player data the sorting and grouping steps look at, stored column by column and indexed by player slot.
+ * This is a snapshot taken once the due colors are known, the players themselves still hold the full data
+ */
+class PlayerTable {
+public:
+    /**
+     * Pairing number (id) of each player
+     */
+    std::vector<int> id;
+    /**
+     * Score of each player in half points
+     */
+    std::vector<int> score;
+    /**
+     * Rating of each player
+     */
+    std::vector<int> rating;
+    /**
+     * Average rating of opponents of each player
+     */
+    std::vector<double> aro;
+    /**
+     * Due color of each player
+     */
+    std::vector<Color> due_color;
+    /**
+     * Color preference strength of each player
+     */
+    std::vector<ColorPreference> strength;
+    /**
+     * Number of times each player has upfloated
+     */
+    std::vector<int> num_upfloated;
+    /**
+     * If each player upfloated in the previous round
+     */
+    std::vector<char> upfloated_prev;
+    /**
+     * If each player has already received a bye
+     */
+    std::vector<char> received_bye;
+    /**
+     * Number of opponents each player has played
+     */
+    std::vector<int> opp_count;
+    
+    /**
+     * Takes the snapshot of the given players. The table has one row for every slot
+     */
+    void build(std::vector<Player> &players);
+    /**
+     * Determines if the player in the given slot can still upfloat in the given round (same as Player::canUpfloat)
+     */
+    bool canUpfloat(int s, int cr) const {return num_upfloated[s] < 2 + cr / 5;}
+};
+
+/**
+ * The engine used to pair a round
+ */
+enum PairingEngine : unsigned char {
+    /**
+     * Pairs score group by score group, backtracking into the lower groups as needed (the default)
+     */
+    SCORE_GROUPS,
+    /**
+     * Pairs the whole round as one minimum cost perfect matching, with the pairing criteria folded into the edge costs
+     */
+    GLOBAL_MATCHING
+};
+
+/**
+ * Limits on how much searching the pairing engine may do for a round. A limit of 0 means no limit
+ */
+struct PairingBudget {
+    /**
+     * Most attempts at pairing a group (see PairingStats::nodes)
+     */
+    long long max_nodes = 0;
+    /**
+     * Most seconds of wall time. The score groups engine only gets half of it, and the rest is kept for the global matching engine in case it has to fall back on it.
+     * The global matching engine always finishes the first matching it solves, so a round is paired even if that takes longer than the budget
+     */
+    double max_seconds = 0;
+};
+
+/**
+ * Counters describing the search done for the last round paired
+ */
+struct PairingStats {
+    /**
+     * Attempts at pairing a group, one for every set of upfloaters tried
+     */
+    long long nodes = 0;
+    /**
+     * Bye players tried
+     */
+    int byes_tried = 0;
+    /**
+     * Brackets found not to pair
+     */
+    long long failed_brackets = 0;
+    /**
+     * Times a bracket already known to fail came up again
+     */
+    long long failed_bracket_hits = 0;
+    /**
+     * Wall time in seconds
+     */
+    double seconds = 0;
+    /**
+     * If the search ran out of budget before finding a pairing. The pairing then comes from the global matching engine, which finds a complete legal pairing whenever there is one, but is not the pairing the score groups would have given.
+     * If the global matching engine runs out of time as well, the pairing is the cheapest it found so far
+     */
+    bool out_of_budget = false;
+};
+
 /**
  * A simple tournament running Dubov system pairings
  */
@@ -214,6 +415,10 @@ private:
      * Players in the tournament
      */
     std::vector<Player> players;
+    /**
+     * Names of the players in the tournament. Copies of the tournament share the pool
+     */
+    std::shared_ptr<NamePool> names = std::make_shared<NamePool>();
     /**
      * Number of players in tournament
      */
@@ -230,19 +435,127 @@ private:
      * If shifters were just applied to a (pairing) group
      */
     bool applied_shifters = false;
+    /**
+     * Set when pairing a group needed players from below the last group (an upfloater for the last group, more upfloaters than the lower groups had, or the weighted upfloater search).
+     * A segment of groups paired on its own only gives the same pairing as all groups paired together if this never happens
+     */
+    bool past_last_group = false;
     /**
      * Just to record the current round globaly
      */
     int current_round = 0;
+    /**
+     * Where the scratch containers of the pairing engine allocate from. This points to the round arena while a round is being paired
+     */
+    std::pmr::memory_resource *scratch = std::pmr::get_default_resource();
+    /**
+     * Where the player in each slot is in players, for the round being paired. Brackets only hold slots, so this is how the engine gets to the player data.
+     * These are indices rather than pointers, so a copy of the tournament looks up its own players
+     */
+    std::vector<int> by_slot;
+    /**
+     * Column snapshot of the players for the round being paired. It is never changed once taken, so the copies of the engine running on worker threads share it
+     */
+    std::shared_ptr<const PlayerTable> table = std::make_shared<const PlayerTable>();
+    /**
+     * Slots of all players in pairing order for the round being paired (points first, then pairing number)
+     */
+    std::vector<int> ranking;
+    /**
+     * Where each score group starts in the ranking, highest score first. The last entry is the number of players
+     */
+    std::vector<int> score_start;
+    /**
+     * The score groups of the round being paired
+     */
+    ScoreGroups groups;
+    /**
+     * The slot of the player getting the bye in the pairing being tried (-1 if nobody)
+     */
+    int current_bye = -1;
+    /**
+     * Brackets of the round being paired which could not be paired, by bracketKey. The value is if the failure needed players past the last group (see past_last_group)
+     */
+    std::map<std::vector<int>, bool> failed_brackets;
+    /**
+     * The search budget for the round being paired
+     */
+    PairingBudget budget;
+    /**
+     * When pairing the round started
+     */
+    std::chrono::steady_clock::time_point search_start;
+    /**
+     * How many seconds after search_start the engine running now has to stop by (0 if there is no time limit)
+     */
+    double deadline = 0;
+    /**
+     * Counters for the round being paired (or the last round paired)
+     */
+    PairingStats stats;
+    /**
+     * Set from another thread when this pairing is no longer needed (only for speculative pairings, see pairByeCandidates). It stops the search the same way running out of budget does
+     */
+    std::atomic<bool> *cancelled = nullptr;
+    /**
+     * Set on the copies of the engine which run on a thread of their own, so they never start more threads
+     */
+    bool on_worker_thread = false;
+    
+    /**
+     * Checks if the search has used up its budget. Once it has, every attempt at pairing a group fails
+     */
+    bool outOfBudget();
+    /**
+     * Checks if the search has used up its time budget (marking it out of budget if so). Unlike outOfBudget this ignores the node limit, so the global matching engine can still run once the score groups engine used up its nodes
+     */
+    bool outOfTime();
+    /**
+     * Checks if this pairing was cancelled from another thread (see cancelled)
+     */
+    bool isCancelled() const;
+    /**
+     * For each slot, who the player was matched with in the last matching the player was part of (-1 for nobody). Used to warm start the next matching
+     */
+    std::vector<int> warm_mate;
+    /**
+     * Scratch space for solveMatching, giving the vertex of each slot (-1 when the slot is not in the graph)
+     */
+    std::vector<int> warm_vertex;
+    /**
+     * Compatibility bit-matrix for the round being paired. Row r holds one bit for every player slot, and the bit is set if the player in slot r can play that player
+     */
+    std::shared_ptr<const std::vector<std::uint64_t>> compatibility = std::make_shared<const std::vector<std::uint64_t>>();
+    /**
+     * Number of 64 bit words in a single row of the compatibility matrix
+     */
+    int compatibility_stride = 0;
     
+    /**
+     * Builds the compatibility matrix for all players in the tournament
+     */
+    void buildCompatibility();
+    /**
+     * Determines if the two players can play each other. This is a single bit test on the compatibility matrix
+     */
+    bool canPlay(int s1, int s2) const {return ((*compatibility)[s1 * compatibility_stride + (s2 >> 6)] >> (s2 & 63)) & 1u;}
+    /**
+     * Gets the player in a given slot
+     */
+    Player &player(int s) {return players[by_slot[s]];}
+    /**
+     * Gets the player in a given slot, without changing it
+     */
+    const Player &player(int s) const {return players[by_slot[s]];}
     /**
      * Divides a given group into to separate subgroups, both being players who are due white and black
      */
-    void splitGroups(std::vector<Player> *white_seekers, std::vector<Player> *black_seekers, std::vector<Player> &group);
+    void splitGroups(std::vector<int> *white_seekers, std::vector<int> *black_seekers, const std::vector<int> &group);
     /**
-     * Gets the next available transpostion
+     * Gets the next available transpostion. Sets of black seekers are held as bitmasks of type Mask, which is a std::array of 64 bit words big enough for the bracket, or a std::vector of them
      */
-    std::shared_ptr<std::vector<MatchEval>> nextTransposition(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, int pof);
+    template<class Mask>
+    std::shared_ptr<std::vector<MatchEval>> nextTransposition(std::vector<int> &white_seekers, std::vector<int> &black_seekers, int pof);
     /**
      * EXPERIMENTAL! Another implementation for applying transpositions
      */
@@ -250,24 +563,24 @@ private:
     /**
      * Evalutes the transpositions
      */
-    void evaluateTranspositions(std::vector<MatchEval> *games_eval, std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, bool *error);
+    void evaluateTranspositions(std::vector<MatchEval> *games_eval, std::vector<int> &white_seekers, std::vector<int> &black_seekers, bool *error);
     /**
      * Moves players from one group to the other
      */
     [[deprecated("Use of migratePlayers has been deprecated. It has been replaced by applyStandardShifters")]]
-    void migratePlayers(std::vector<Player> *g1, std::vector<Player> *g2);
+    void migratePlayers(std::vector<int> *g1, std::vector<int> *g2);
     /**
      * Generates a migration queue for a given group
      */
-    std::vector<int> generateMigrationQueue(const std::vector<Player> &for_group) const;
+    std::vector<int> generateMigrationQueue(const std::vector<int> &for_group) const;
     /**
      * For merging upfloat wrappers
      */
-    void mergeUpfloaterWrappers(const std::vector<Player> &wrong_colors, const std::vector<Player> &max_upfloat, std::vector<Player> *upfloaters);
+    void mergeUpfloaterWrappers(const std::vector<int> &wrong_colors, const std::vector<int> &max_upfloat, std::vector<int> *upfloaters);
     /**
      * Merges matches in the recursive call
      */
-    void mergeMatches(const std::vector<Match> &m1, std::vector<Match> *main);
+    void mergeMatches(const std::vector<SlotMatch> &m1, std::vector<SlotMatch> *main);
     /**
      * Determines which player should recieve their due color, and returns the ID of the player
      */
@@ -275,51 +588,54 @@ private:
     /**
      * Optimizes the colors of the matches to make sure that all of criteria E is met
      */
-    void optimizeColors(std::vector<Match> *games);
+    void optimizeColors(std::vector<SlotMatch> *games);
     /**
-     * Finds a list of upfloaters for a given imbalanced group
+     * Finds a list of upfloaters for a given imbalanced group, looking at the groups from next_group downwards
      */
-    std::vector<Player> findUpfloaters(LinkedListNode &next_group, int imbalance);
+    std::vector<int> findUpfloaters(int next_group, int imbalance);
     /**
      * Applies the exhcnages given the minimum number of shifters to move
      */
-    void getExchangeShifters(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, std::vector<int> &w_shift, std::vector<int> &b_shift, bool &error);
+    void getExchangeShifters(std::vector<int> &white_seekers, std::vector<int> &black_seekers, std::vector<int> &w_shift, std::vector<int> &b_shift, bool &error);
+    /**
+     * Solves the minimum cost perfect matching of a graph, using the bipartite solver whenever the graph is bipartite.
+     * If vertex_slots (the slot of each vertex) is given, the matching is warm started from the last matchings of those players.
+     * A maximum cardinality matching is always found first, and the weighted solve is skipped when it is not perfect.
+     * If deficiency is given, it is set to the number of vertices the maximum cardinality matching leaves unmatched (0 when a perfect matching exists)
+     */
+    std::pair<std::vector<int>, int> solveMatching(const Graph &g, const std::vector<int> &cost, const std::pmr::vector<int> *vertex_slots = nullptr, int *deficiency = nullptr);
     /**
      * Applies shifters to ws or bs. This is specifically when one of those two groups are larger than the other
      */
-    void applyStandardShifters(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, bool &error);
+    void applyStandardShifters(std::vector<int> &white_seekers, std::vector<int> &black_seekers, bool &error);
     /**
      * Generates the order floaters should be selected given the next group and the current imbalance situation
      */
-    std::queue<Player> generateFloatQueue(LinkedListNode &next_group, int color_imbalance) const;
+    std::queue<int> generateFloatQueue(int next_group, int color_imbalance) const;
     /**
      * Similar to findMultiUpfloaters, but it designed for groups with an even number of whites and blacks (i.e. white seekers size is == to black seekers size)
      */
-    std::set<int> findMultiUpfloatersNP(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, LinkedListNode &next_group, Graph &g, std::vector<double> &cost, const std::map<int, int> &p_convert, const std::vector<Player> &p_reverse);
+    std::set<int> findMultiUpfloatersNP(std::vector<int> &white_seekers, std::vector<int> &black_seekers, int next_group, Graph &g, std::vector<int> &cost, const std::pmr::map<int, int> &p_convert, const std::pmr::vector<int> &p_reverse);
     /**
-     * Finds the next set of upfloaters that can satisfy the pairing. This returns the ids of all the players who should be the upfloaters
+     * Finds the next set of upfloaters that can satisfy the pairing. This returns the slots of all the players who should be the upfloaters
      */
-    std::set<int> findMultiUpfloaters(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, LinkedListNode &next_group, bool &error);
+    std::set<int> findMultiUpfloaters(std::vector<int> &white_seekers, std::vector<int> &black_seekers, int next_group, bool &error);
     /**
-     * Recreates the new groups by removing all upfloaters from the lower groups
+     * Pulls all upfloaters out of the groups from next_group downwards, and adds them to the white or black seekers
      */
-    LinkedListNode makeNewGroups(const LinkedListNode &old_groups, const std::set<int> &upfloaters, std::vector<Player> *white_seekers, std::vector<Player> *black_seekers) const;
+    void pullUpfloaters(int next_group, const std::set<int> &upfloaters, std::vector<int> *white_seekers, std::vector<int> *black_seekers);
     /**
      * Converts the match eval games to normal matches
      */
-    std::vector<Match> castToMatch(const std::vector<MatchEval> &games_eval);
+    std::vector<SlotMatch> castToMatch(const std::vector<MatchEval> &games_eval);
     /**
-     * Maximizes the pairings for a group
+     * Turns the paired slots into matches between the actual players
      */
-    std::vector<Match> maximizePairings(std::vector<Player> &white_seekers, std::vector<Player> &black_seekers, bool *pairing_error);
+    std::vector<Match> makeMatches(const std::vector<SlotMatch> &games) const;
     /**
-     * For merge sort (sorting players by ARO)
-     */
-    void mergeGroupARO(std::vector<Player> *group, int const left, int const mid, int const right);
-    /**
-     * For merge sort (soring players by points)
+     * Maximizes the pairings for a group
      */
-    static void playersPointsMerge(std::vector<Player> *players, int const left, int const mid, int const right);
+    std::vector<SlotMatch> maximizePairings(std::vector<int> &white_seekers, std::vector<int> &black_seekers, bool *pairing_error);
     /**
      * For sorting players by points
      */
@@ -327,7 +643,15 @@ private:
     /**
      * Sorts a group by ARO (average rating of opponent)
      */
-    void sortGroupARO(std::vector<Player> *group, int const begin, int const end);
+    void sortGroupARO(std::vector<int> *group, int const begin, int const end);
+    /**
+     * Sorts a group by rating (which is the pairing number order)
+     */
+    void sortGroupRating(std::vector<int> *group) const;
+    /**
+     * Builds the ranking of all players by points, and then by pairing number. The score groups come from a counting sort on the scores
+     */
+    void rankPlayers();
     /**
      * Makes round 1 pairings
      */
@@ -337,13 +661,49 @@ private:
      */
     std::vector<Match> makeRoundRobinRound(int pairing_round);
     /**
-     * Makes the groups for the players
+     * Makes the groups for the players, leaving out the player in the given slot (the bye player)
+     */
+    ScoreGroups makeGroups(int bye_slot = -1) const;
+    /**
+     * Makes a pairing for a group (and all groups below it).
+     * Brackets which already failed this round fail again right away, without pairing anything
+     */
+    std::vector<SlotMatch> makePairingForGroup(int g, int pairing_round);
+    /**
+     * Does the actual pairing for makePairingForGroup
+     */
+    std::vector<SlotMatch> pairGroup(int g, int pairing_round);
+    /**
+     * Pairs the given group with the given upfloater pulled up into it, and then all groups below it. Sets pairing_error if this does not work
+     */
+    std::vector<SlotMatch> pairWithUpfloater(int g, int floater, std::vector<int> white_seekers, std::vector<int> black_seekers, int pairing_round);
+    /**
+     * Checks if the given number of upfloaters left for the given group are worth trying at the same time (see pairUpfloaterCandidates)
+     */
+    bool splitUpfloaters(int g, int candidates) const;
+    /**
+     * Tries all the given upfloaters for the given group at the same time. Each thread takes the next upfloater nobody has started on yet, and pairs it on its own copy of the engine (see pairWithUpfloater).
+     * The first upfloater (in the given order) that works is used, and the upfloaters after it are cancelled, so the result is always the same as trying the upfloaters one after the other.
+     * Sets pairing_error if none of them work
+     */
+    std::vector<SlotMatch> pairUpfloaterCandidates(int g, const std::vector<int> &floaters, const std::vector<int> &white_seekers, const std::vector<int> &black_seekers, int pairing_round);
+    /**
+     * Gets a key for who is left in the given group and all groups below it. Pairing those groups always turns out the same for the same key.
+     * The key is the score of the group, the bye player if the bye player would otherwise be in these groups (-1 if not), and then everybody pulled up out of these groups
+     */
+    std::vector<int> bracketKey(int g) const;
+    /**
+     * Pairs all the groups, same as makePairingForGroup(0, pairing_round).
+     * Large rounds are cut into segments of groups at points where the players above add up to an even number, and the segments are paired at the same time on separate threads (unless there is a node budget).
+     * The segment pairings are used (in group order) only if every segment was paired without needing anyone below it, otherwise the groups are paired one after the other
      */
-    LinkedList makeGroups() const;
+    std::vector<SlotMatch> pairSegments(int pairing_round);
     /**
-     * Makes a pairing for a group
+     * Pairs the round for each of the given bye players at the same time, each on its own thread and its own copy of the engine.
+     * Returns the index of the first bye player (in the given order) the round could be paired with, and puts those games in games. Returns -1 if none of them work.
+     * Bye players after one that works are cancelled, so the result is always the same as trying the bye players one after the other
      */
-    std::vector<Match> makePairingForGroup(LinkedListNode *g, int pairing_round);
+    int pairByeCandidates(const std::vector<int> &bye_slots, int pairing_round, std::vector<SlotMatch> *games);
     /**
      * Initializes all due colors for the players
      */
@@ -352,14 +712,26 @@ private:
      * Makes subsequent round pairings
      */
     std::vector<Match> makeSubsequent(int pairing_round);
+    /**
+     * Pairs all players except the one in the given slot (the bye player) with a single minimum cost perfect matching.
+     * The edge costs rank the criteria one after the other: score differences (squared), number of upfloaters, upfloat restrictions, color preferences and lastly the rating and ARO order.
+     * The matching is first solved on the games between players close in the ranking, and the games left out which its duals show could make it cheaper are added until none are left, so the minimum is the same as with every game in the graph.
+     * Returns an empty vector if the players cannot all be paired. If the round has too many players for the costs to fit, pairing_error is set as well.
+     * The first matching is always solved all the way, but if the time budget runs out after that, the cheapest matching found so far is used, which pairs everybody but might not be the minimum
+     */
+    std::vector<SlotMatch> pairGlobally(int bye_slot);
+    /**
+     * Makes subsequent round pairings with the global matching engine
+     */
+    std::vector<Match> makeGlobalSubsequent(int pairing_round);
     /**
      * For getting matches of a specific round
      */
     std::vector<Utils::TRFMatch> extractedMatch;
     /**
-     * Removes the bye player and returns the index of the bye player removed from
+     * Finds the slot of the player with the given id, or -1 if there is no such player
      */
-    int removeByePlayer(std::vector<Player> *players, int bye_remove, Player *p_bye) const;
+    int findSlot(int id) const;
     /**
      * The bye stack
      */
@@ -367,7 +739,7 @@ private:
     /**
      * Gets the index of the player who should get the bye
      */
-    std::vector<int> getByePlayerStack(const std::vector<Player> &selection, int current_round) const;
+    std::vector<int> getByePlayerStack(const std::vector<int> &selection, int current_round) const;
     /**
      * Fixes the colors for round 1 baku acceleration
      */
@@ -394,6 +766,10 @@ public:
      * A simple getter for pairing\_error
      */
     bool pairingErrorOccured() const {return pairing_error;}
+    /**
+     * Gets the counters describing the search done for the last round paired
+     */
+    const PairingStats &getPairingStats() const {return stats;}
     /**
      * A simple getter for player count
      */
@@ -402,10 +778,19 @@ public:
      * Generates pairings for a given round
      */
     std::vector<Match> generatePairings(int r);
+    /**
+     * Generates pairings for a given round with the given engine
+     */
+    std::vector<Match> generatePairings(int r, PairingEngine engine);
+    /**
+     * Generates pairings for a given round with the given engine, searching no more than the budget allows.
+     * If the score groups engine runs out of budget, the pairing comes from the global matching engine instead (see PairingStats::out_of_budget). The score groups engine only gets half of the time budget, so the global matching engine has the other half to look for the cheapest pairing it can find
+     */
+    std::vector<Match> generatePairings(int r, PairingEngine engine, const PairingBudget &budget);
     /**
      * Generates pairings for a given round with baku acceleration
      */
-    std::vector<Match> generatePairings(int r, bool baku_acceleration);
+    std::vector<Match> generatePairings(int r, bool baku_acceleration, PairingEngine engine = PairingEngine::SCORE_GROUPS, const PairingBudget &budget = PairingBudget());
     /**
      * Gets the raw matches extracted from a particular round
      */
@@ -78,14 +78,14 @@ void CPPDubovSystem::BakuAcceleration::accelerate() {
     int bound1 = 0;
     int bound2 = 0;
     
-    double curr_pt = (*this->players)[0].getPoints();
+    int curr_pt = (*this->players)[0].getHalfPoints();
     
     int n = 0;
     
     for(int i = 1; i < this->players->size(); i++) {
         Player p = (*this->players)[0];
         // check if scores match
-        if(p.getPoints() != curr_pt) {
+        if(p.getHalfPoints() != curr_pt) {
             // group end point found!
             bound2 = i - 1;
             group_bounds.push_back(std::make_pair(bound1, bound2));
@@ -134,20 +134,20 @@ std::string fpc::PairingsChecker::outputReport() {
     for(int i = 0; i < this->games_expected.size(); i++) {
         std::string wp = "(" + std::to_string(this->games_expected[i].white.getPoints()) + ")";
         std::string bp = "(" + std::to_string(this->games_expected[i].black.getPoints()) + ")";
-        output += this->games_expected[i].white.getName() + wp + " - ";
+        output += std::string(this->games_expected[i].white.getName()) + wp + " - ";
         if(this->games_expected[i].is_bye) {
             output += "BYE\n";
         } else {
-            output += this->games_expected[i].black.getName() + bp + "\n";
+            output += std::string(this->games_expected[i].black.getName()) + bp + "\n";
         }
     }
     output += "\nTOURNAMENT PAIRINGS (TO CHECK):\n\n";
     for(int i = 0; i < this->match_check.size(); i++) {
         std::string wp = "(" + std::to_string(this->players_scaned[this->match_check[i].getWID()].getPoints()) + ")";
         std::string bp = "(" + std::to_string(this->players_scaned[this->match_check[i].getBID()].getPoints()) + ")";
-        output += this->players_scaned[this->match_check[i].getWID()].getName() + wp + " - ";
+        output += std::string(this->players_scaned[this->match_check[i].getWID()].getName()) + wp + " - ";
         //TODO: BYE CHECK
-        output += this->players_scaned[this->match_check[i].getBID()].getName() + bp + "\n";
+        output += std::string(this->players_scaned[this->match_check[i].getBID()].getName()) + bp + "\n";
     }
     
     output += "\nERRORS TOTAL DETECTED IN TOURNAMENT PAIRINGS: " + std::to_string(this->bad_opp + this->bad_color);
@@ -157,11 +157,11 @@ std::string fpc::PairingsChecker::outputReport() {
     // output any pairings not found
     output += "\nEXPECTED GAMES NOT FOUND IN PAIRINGS CHECKED:\n";
     for(int i = 0; i < this->games_no_found.size(); i++) {
-        output += "\n" + this->games_no_found[i].white.getName() + " (" + std::to_string(this->games_no_found[i].white.getPoints()) + ")";
+        output += "\n" + std::string(this->games_no_found[i].white.getName()) + " (" + std::to_string(this->games_no_found[i].white.getPoints()) + ")";
         if(this->games_no_found[i].is_bye) {
             output += " - BYE";
         } else {
-            output += " - " + this->games_no_found[i].black.getName() + " (" + std::to_string(this->games_no_found[i].black.getPoints()) + ")";
+            output += " - " + std::string(this->games_no_found[i].black.getName()) + " (" + std::to_string(this->games_no_found[i].black.getPoints()) + ")";
         }
     }
     
@@ -173,3 +173,118 @@ std::string fpc::PairingsChecker::outputReport() {
     
     return output;
 }
+
+fpc::EngineDiff::EngineDiff(const std::vector<std::string> &paths) {
+    this->paths = paths;
+}
+
+std::set<std::string> fpc::EngineDiff::pairRound(const TRFUtil::TRFData &raw_data, int round, CPPDubovSystem::PairingEngine engine, bool *error) const {
+    // rebuild the tournament as it was before the round
+    int next_round = 0; // dummy variable
+    CPPDubovSystem::Tournament t = CPPDubovSystem::Tournament::makeTournament(raw_data, &next_round, round);
+    std::vector<CPPDubovSystem::Match> games = t.generatePairings(round, raw_data.isAccelerationOn(), engine);
+    *error = t.pairingErrorOccured() || games.empty();
+    
+    // same hash as the pairings checker uses
+    std::set<std::string> boards;
+    for(int i = 0; i < games.size(); i++) {
+        std::string hash = std::to_string(games[i].white.getID()) + "_";
+        if(games[i].is_bye) {
+            hash += "bye";
+        } else {
+            hash += std::to_string(games[i].black.getID());
+        }
+        boards.insert(hash);
+    }
+    
+    return boards;
+}
+
+std::string fpc::EngineDiff::outputReport() {
+    std::string output = "----------CPP FIDE DUBOV SYSTEM ENGINE DIFF REPORT----------\n";
+    
+    int total_rounds = 0;
+    int same_rounds = 0;
+    int total_boards = 0;
+    int same_boards = 0;
+    int color_boards = 0;
+    int group_errors = 0;
+    int global_errors = 0;
+    
+    for(int p = 0; p < this->paths.size(); p++) {
+        TRFUtil::TRFFile trf_read(this->paths[p]);
+        TRFUtil::TRFData raw_data = trf_read.read();
+        if(!raw_data.tnrCodeExists()) {
+            output += "\n" + this->paths[p] + ": SKIPPED (missing tournament number of rounds)\n";
+            continue;
+        }
+        
+        // find out how many rounds were played
+        int rounds_played = 0;
+        CPPDubovSystem::Tournament::makeTournament(raw_data, &rounds_played);
+        
+        output += "\n" + this->paths[p] + "\n";
+        // round 1 is the same for both engines, so start at round 2
+        for(int r = 2; r <= rounds_played; r++) {
+            bool group_error = false;
+            bool global_error = false;
+            std::set<std::string> group_boards = this->pairRound(raw_data, r, CPPDubovSystem::PairingEngine::SCORE_GROUPS, &group_error);
+            std::set<std::string> global_boards = this->pairRound(raw_data, r, CPPDubovSystem::PairingEngine::GLOBAL_MATCHING, &global_error);
+            
+            total_rounds += 1;
+            group_errors += group_error ? 1 : 0;
+            global_errors += global_error ? 1 : 0;
+            
+            // count the boards both engines agree on, and the ones that only differ in colors
+            int same = 0;
+            int colors = 0;
+            std::vector<std::string> only_group;
+            for(const std::string &b : group_boards) {
+                if(global_boards.contains(b)) {
+                    same += 1;
+                    continue;
+                }
+                size_t split = b.find('_');
+                std::string reversed = b.substr(split + 1) + "_" + b.substr(0, split);
+                if(global_boards.contains(reversed)) {
+                    colors += 1;
+                } else {
+                    only_group.push_back(b);
+                }
+            }
+            
+            int boards = (int) std::max(group_boards.size(), global_boards.size());
+            total_boards += boards;
+            same_boards += same;
+            color_boards += colors;
+            if(same == boards && group_boards.size() == global_boards.size()) {
+                same_rounds += 1;
+            }
+            
+            output += "ROUND " + std::to_string(r) + ": " + std::to_string(same) + "/" + std::to_string(boards) + " SAME, " + std::to_string(colors) + " COLORS ONLY";
+            if(group_error) output += ", SCORE GROUP ENGINE FAILED";
+            if(global_error) output += ", GLOBAL ENGINE FAILED";
+            output += "\n";
+            for(int i = 0; i < only_group.size(); i++) {
+                output += "    ONLY SCORE GROUP ENGINE: " + only_group[i] + "\n";
+            }
+            for(const std::string &b : global_boards) {
+                if(group_boards.contains(b)) continue;
+                size_t split = b.find('_');
+                std::string reversed = b.substr(split + 1) + "_" + b.substr(0, split);
+                if(group_boards.contains(reversed)) continue;
+                output += "    ONLY GLOBAL ENGINE: " + b + "\n";
+            }
+        }
+    }
+    
+    output += "\nROUNDS IDENTICAL/TOTAL: " + std::to_string(same_rounds) + "/" + std::to_string(total_rounds);
+    output += "\nBOARDS IDENTICAL/TOTAL: " + std::to_string(same_boards) + "/" + std::to_string(total_boards);
+    output += "\nBOARDS WITH COLORS REVERSED: " + std::to_string(color_boards);
+    output += "\nROUNDS THE SCORE GROUP ENGINE FAILED: " + std::to_string(group_errors);
+    output += "\nROUNDS THE GLOBAL ENGINE FAILED: " + std::to_string(global_errors);
+    
+    output += "\n\nENGINE DIFF REPORT DONE\n";
+    
+    return output;
+}
@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <vector>
 #include <memory>
+#include <set>
 #include "trf util/trf.hpp"
 #include "Tournament.hpp"
 #include "Player.hpp"
@@ -104,6 +105,30 @@ public:
      */
     std::string outputReport();
 };
+
+/**
+ * Diffs the global matching engine against the score group engine. Every round of every TRF file is paired again with both engines, from the same tournament state
+ */
+class EngineDiff {
+private:
+    /**
+     * Paths of the TRF files to run through
+     */
+    std::vector<std::string> paths;
+    /**
+     * Pairs the given round of the tournament in the file with the given engine. Each board is turned into a key, so the order of the boards doesn't matter
+     */
+    std::set<std::string> pairRound(const TRFUtil::TRFData &raw_data, int round, CPPDubovSystem::PairingEngine engine, bool *error) const;
+public:
+    /**
+     * Takes the paths of all the TRF files to diff
+     */
+    explicit EngineDiff(const std::vector<std::string> &paths);
+    /**
+     * Runs both engines on every round and returns the string representation of the report
+     */
+    std::string outputReport();
+};
 }
 
 #endif /* fpc_hpp */
@@ -0,0 +1,283 @@
+#include "BipartiteMatching.h"
+#include <algorithm>
+#include <queue>
+
+template<class CostType>
+BipartiteMatching<CostType>::BipartiteMatching(const Graph & G, const vector<int> & side):
+	G(G),
+	rows(1, -1),
+	cols(1, -1),
+	index(G.GetNumVertices())
+{
+	for(int v = 0; v < G.GetNumVertices(); v++)
+	{
+		if(side[v] == 0)
+		{
+			index[v] = (int) rows.size();
+			rows.push_back(v);
+		}
+		else
+		{
+			index[v] = (int) cols.size();
+			cols.push_back(v);
+		}
+	}
+}
+
+template<class CostType>
+bool BipartiteMatching<CostType>::IsBipartite(const Graph & G, vector<int> & side)
+{
+	int n = G.GetNumVertices();
+	side.assign(n, -1);
+
+	//Color each component with a BFS, starting from its lowest vertex
+	queue<int> q;
+	for(int s = 0; s < n; s++)
+	{
+		if(side[s] != -1) continue;
+
+		side[s] = 0;
+		q.push(s);
+		while(!q.empty())
+		{
+			int u = q.front();
+			q.pop();
+
+			for(int v : G.AdjList(u))
+			{
+				if(side[v] == -1)
+				{
+					side[v] = 1 - side[u];
+					q.push(v);
+				}
+				else if(side[v] == side[u])
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+template<class CostType>
+vector<int> BipartiteMatching<CostType>::SolveMaximumMatching(const Graph & G, const vector<int> & side)
+{
+	int n = G.GetNumVertices();
+
+	//mate[v] is the vertex matched to v and mateEdge[v] the edge used for it
+	//dist[u] is the layer of a side 0 vertex in the current phase (-1 if it cannot be reached, or is a dead end)
+	//next[u] is the next edge of u the search will try
+	vector<int> mate(n, -1), mateEdge(n, -1), dist(n, -1), next(n, 0);
+	vector<int> q, path;
+	q.reserve(n);
+	path.reserve(n);
+
+	while(true)
+	{
+		//Layer the side 0 vertices by their distance from the free ones with a BFS
+		q.clear();
+		for(int u = 0; u < n; u++)
+		{
+			if(side[u] != 0) continue;
+
+			dist[u] = -1;
+			if(mate[u] == -1)
+			{
+				dist[u] = 0;
+				q.push_back(u);
+			}
+		}
+
+		bool found = false;
+		for(int h = 0; h < (int) q.size(); h++)
+		{
+			int u = q[h];
+			for(int v : G.AdjList(u))
+			{
+				int w = mate[v];
+				if(w == -1)
+					found = true;
+				else if(dist[w] == -1)
+				{
+					dist[w] = dist[u] + 1;
+					q.push_back(w);
+				}
+			}
+		}
+
+		//No augmenting path is left, so the matching is maximum
+		if(not found) break;
+
+		//Augment along shortest paths with a DFS that only goes down the layers
+		for(int u = 0; u < n; u++)
+			next[u] = 0;
+
+		for(int r = 0; r < n; r++)
+		{
+			if(side[r] != 0 or mate[r] != -1) continue;
+
+			path.clear();
+			path.push_back(r);
+			while(!path.empty())
+			{
+				int u = path.back();
+				span<const int> adj = G.AdjList(u);
+
+				//Every edge of u was tried, so u is a dead end for the rest of the phase
+				if(next[u] == (int) adj.size())
+				{
+					dist[u] = -1;
+					path.pop_back();
+					if(!path.empty())
+						next[path.back()]++;
+					continue;
+				}
+
+				int w = mate[adj[next[u]]];
+				if(w == -1)
+				{
+					//Found a free vertex, flip the matching along the path
+					for(int i = (int) path.size() - 1; i >= 0; i--)
+					{
+						int a = path[i];
+						int b = G.AdjList(a)[next[a]];
+						mate[a] = b;
+						mate[b] = a;
+						mateEdge[a] = mateEdge[b] = G.AdjEdges(a)[next[a]];
+					}
+					break;
+				}
+
+				if(dist[w] == dist[u] + 1)
+					path.push_back(w);
+				else
+					next[u]++;
+			}
+		}
+	}
+
+	vector<int> matching;
+	for(int u = 0; u < n; u++)
+		if(side[u] == 0 and mate[u] != -1)
+			matching.push_back(mateEdge[u]);
+	sort(matching.begin(), matching.end());
+
+	return matching;
+}
+
+template<class CostType>
+pair< vector<int>, CostType > BipartiteMatching<CostType>::SolveMinimumCostPerfectMatching(const vector<CostType> & cost)
+{
+	//A perfect matching needs both sides to be the same size
+	int k = (int) rows.size() - 1;
+	if(k != (int) cols.size() - 1)
+		return make_pair(vector<int>(), -1);
+
+	//u and v are the potentials of the rows and columns
+	//p[j] is the row matched to column j, and pe[j] the edge used for it (column 0 is a dummy)
+	vector<WorkType> u(k+1, 0), v(k+1, 0), minv(k+1, 0);
+	vector<int> p(k+1, 0), pe(k+1, -1), way(k+1, 0), wayEdge(k+1, -1);
+	vector<bool> used(k+1, false), reached(k+1, false);
+
+	for(int i = 1; i <= k; i++)
+	{
+		//Give up if the caller no longer wants the answer
+		if(stop and stop())
+			return make_pair(vector<int>(), -1);
+
+		//Grow a shortest augmenting path from row i
+		p[0] = i;
+		int j0 = 0;
+		fill(used.begin(), used.end(), false);
+		fill(reached.begin(), reached.end(), false);
+		do
+		{
+			used[j0] = true;
+			int i0 = p[j0];
+
+			//Only the edges of row i0 need looking at
+			span<const int> adj = G.AdjList(rows[i0]);
+			span<const int> adjEdges = G.AdjEdges(rows[i0]);
+			for(int t = 0; t < (int) adj.size(); t++)
+			{
+				int j = index[adj[t]];
+				if(used[j]) continue;
+
+				WorkType cur = (WorkType) cost[adjEdges[t]] - u[i0] - v[j];
+				if(!reached[j] or cur < minv[j])
+				{
+					minv[j] = cur;
+					way[j] = j0;
+					wayEdge[j] = adjEdges[t];
+					reached[j] = true;
+				}
+			}
+
+			int j1 = 0;
+			WorkType delta = 0;
+			for(int j = 1; j <= k; j++)
+			{
+				if(used[j] or !reached[j]) continue;
+				if(j1 == 0 or minv[j] < delta)
+				{
+					delta = minv[j];
+					j1 = j;
+				}
+			}
+
+			//No column can be reached any more, so there is no perfect matching
+			if(j1 == 0)
+				return make_pair(vector<int>(), -1);
+
+			for(int j = 0; j <= k; j++)
+			{
+				if(used[j])
+				{
+					u[p[j]] += delta;
+					v[j] -= delta;
+				}
+				else if(reached[j])
+					minv[j] -= delta;
+			}
+			j0 = j1;
+		} while(p[j0] != 0);
+
+		//Flip the matching along the path
+		do
+		{
+			int j1 = way[j0];
+			p[j0] = p[j1];
+			pe[j0] = wayEdge[j0];
+			j0 = j1;
+		} while(j0 != 0);
+	}
+
+	potential.assign(G.GetNumVertices(), 0);
+	for(int i = 1; i <= k; i++)
+	{
+		potential[rows[i]] = u[i];
+		potential[cols[i]] = v[i];
+	}
+
+	//Return the edges in increasing order of index, as Matching does
+	vector<int> matching;
+	for(int j = 1; j <= k; j++)
+		matching.push_back(pe[j]);
+	sort(matching.begin(), matching.end());
+
+	CostType obj = 0;
+	for(int i = 0; i < (int) matching.size(); i++)
+		obj += cost[matching[i]];
+
+	return pair< vector<int>, CostType >(matching, obj);
+}
+
+template<class CostType>
+bool BipartiteMatching<CostType>::IsDualFeasible(int u, int v, CostType cost) const
+{
+	return (WorkType) cost - potential[u] - potential[v] >= 0;
+}
+
+//The cost types used, same as Matching
+template class BipartiteMatching<double>;
+template class BipartiteMatching<int>;
+template class BipartiteMatching<long long>;
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Graph.h"
+#include <functional>
+#include <type_traits>
+#include <vector>
+using namespace std;
+
+//Minimum cost perfect matching for bipartite graphs (Hungarian algorithm with shortest augmenting paths)
+//Gives the same kind of answer as Matching, without any of the blossom handling
+template<class CostType = double>
+class BipartiteMatching
+{
+public:
+	//Parametric constructor receives a graph instance and the side (0 or 1) of every vertex, as given by IsBipartite
+	BipartiteMatching(const Graph & G, const vector<int> & side);
+
+	//Checks if the graph is bipartite
+	//If it is, side[v] is set to the side (0 or 1) of vertex v
+	static bool IsBipartite(const Graph & G, vector<int> & side);
+
+	//Finds a maximum cardinality matching with the Hopcroft-Karp algorithm, in O(E sqrt(V))
+	//Much cheaper than the minimum cost solve, so it is used to check that a perfect matching exists first
+	//side is the side (0 or 1) of every vertex, as given by IsBipartite
+	//Returns a vector with the indices of the edges in the matching, in increasing order
+	static vector<int> SolveMaximumMatching(const Graph & G, const vector<int> & side);
+
+	//Solves the minimum cost perfect matching problem
+	//Receives the a vector whose position i has the cost of the edge with index i
+	//Returns a pair, just like Matching
+	//the first element of the pair is a vector of the indices of the edges in the matching (empty if there is no perfect matching)
+	//the second is the cost of the matching (-1 if there is no perfect matching)
+	pair< vector<int>, CostType > SolveMinimumCostPerfectMatching(const vector<CostType> & cost);
+
+	//Gives a check that is called before every augmenting path of the minimum cost solve, just like Matching
+	//Once it returns true the solve gives up and returns the same as when there is no perfect matching
+	void SetStop(const function<bool()> & check) { stop = check; };
+
+	//Checks if an edge u-v with the given cost, in the graph or not, keeps the potentials of the last solve feasible, just like Matching
+	//u and v don't need to be on different sides
+	//Only valid after a solve that found a perfect matching
+	bool IsDualFeasible(int u, int v, CostType cost) const;
+
+private:
+	//Integer costs are added up in long long, so the potentials can never overflow
+	typedef typename conditional<is_integral<CostType>::value, long long, CostType>::type WorkType;
+
+	const Graph & G;
+
+	//rows[i] is the vertex of the i-th row (side 0), cols[j] is the vertex of the j-th column (side 1), both 1-indexed
+	vector<int> rows, cols;
+	//index[v] is the row or column of vertex v
+	vector<int> index;
+	//Checked before every augmenting path, empty if the solve always runs to the end
+	function<bool()> stop;
+	//potential[v] is the potential of vertex v after the last solve
+	vector<WorkType> potential;
+};
+
+extern template class BipartiteMatching<double>;
+extern template class BipartiteMatching<int>;
+extern template class BipartiteMatching<long long>;
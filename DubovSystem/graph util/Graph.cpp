@@ -1,12 +1,11 @@
 #include "Graph.h"
+#include <algorithm>
+#include <new>
 
 Graph::Graph(int n, const list< pair<int, int> > & edges):
 	n(n),
-	m((int) edges.size()),
-	adjMat(n, vector<bool>(n, false)),
-	adjList(n),
-	edges(),
-	edgeIndex(n, vector<int>(n, -1))
+	m(0),
+	edges()
 {
 	for(list< pair<int, int> >::const_iterator it = edges.begin(); it != edges.end(); it++)
 	{
@@ -19,63 +18,235 @@ Graph::Graph(int n, const list< pair<int, int> > & edges):
 
 pair<int, int> Graph::GetEdge(int e) const
 {
-	if(e > (int)edges.size())
-		throw "Error: edge does not exist";
+	pair<int, int> edge;
+	GraphStatus status = TryGetEdge(e, edge);
+	if(status != GRAPH_OK)
+		ThrowStatus(status);
 
-	return edges[e];
+	return edge;
 }
 
 int Graph::GetEdgeIndex(int u, int v) const
 {
-	if( u > n or
-		v > n )
-		throw "Error: vertex does not exist";
+	int e;
+	GraphStatus status = TryGetEdgeIndex(u, v, e);
+	if(status != GRAPH_OK)
+		ThrowStatus(status);
 
-	if(edgeIndex[u][v] == -1)
-		throw "Error: edge does not exist";
+	return e;
+}
+
+int Graph::FindEdge(int u, int v) const
+{
+	Freeze();
 
-	return edgeIndex[u][v];
+	//Binary search for v among the sorted neighbors of u
+	const int * first = sortedVertex.data() + adjStart[u];
+	const int * last = sortedVertex.data() + adjStart[u+1];
+	const int * it = lower_bound(first, last, v);
+	if(it == last or *it != v)
+		return -1;
+
+	return sortedEdge[it - sortedVertex.data()];
 }
 
 void Graph::AddVertex()
 {
+	n++;
+	frozen = false;
+}
+
+void Graph::AddEdge(int u, int v)
+{
+	GraphStatus status = TryAddEdge(u, v);
+	if(status != GRAPH_OK)
+		ThrowStatus(status);
+}
+
+span<const int> Graph::AdjList(int v) const
+{
+	span<const int> adj;
+	GraphStatus status = TryAdjList(v, adj);
+	if(status != GRAPH_OK)
+		ThrowStatus(status);
+
+	return adj;
+}
+
+span<const int> Graph::AdjEdges(int v) const
+{
+	span<const int> adj;
+	GraphStatus status = TryAdjEdges(v, adj);
+	if(status != GRAPH_OK)
+		ThrowStatus(status);
+
+	return adj;
+}
+
+void Graph::Freeze() const
+{
+	if(frozen) return;
+
+	//Count the degree of each vertex, then turn the counts into offsets
+	adjStart.assign(n+1, 0);
+	for(int i = 0; i < m; i++)
+	{
+		adjStart[edges[i].first+1]++;
+		adjStart[edges[i].second+1]++;
+	}
 	for(int i = 0; i < n; i++)
+		adjStart[i+1] += adjStart[i];
+
+	//Fill in the neighbors in the order the edges were added
+	adjVertex.assign(2*m, 0);
+	adjEdge.assign(2*m, 0);
+	vector<int> fill(adjStart.begin(), adjStart.end() - 1);
+	for(int i = 0; i < m; i++)
 	{
-		adjMat[i].push_back(false);
-		edgeIndex[i].push_back(-1);
+		int u = edges[i].first;
+		int v = edges[i].second;
+
+		adjVertex[fill[u]] = v;
+		adjEdge[fill[u]++] = i;
+		adjVertex[fill[v]] = u;
+		adjEdge[fill[v]++] = i;
 	}
-	n++;
-	adjMat.push_back( vector<bool>(n, false) );
-	edgeIndex.push_back( vector<int>(n, -1) );
-	adjList.push_back( list<int>() );
+
+	//Sort each row by neighbor for the edge lookups
+	sortedVertex.assign(2*m, 0);
+	sortedEdge.assign(2*m, 0);
+	vector< pair<int, int> > row;
+	for(int u = 0; u < n; u++)
+	{
+		row.clear();
+		for(int i = adjStart[u]; i < adjStart[u+1]; i++)
+			row.push_back(pair<int, int>(adjVertex[i], adjEdge[i]));
+		sort(row.begin(), row.end());
+		for(int i = 0; i < (int) row.size(); i++)
+		{
+			sortedVertex[adjStart[u] + i] = row[i].first;
+			sortedEdge[adjStart[u] + i] = row[i].second;
+		}
+	}
+
+	frozen = true;
 }
 
-void Graph::AddEdge(int u, int v)
+GraphStatus Graph::TryGetEdge(int e, pair<int, int> & edge) const noexcept
+{
+	if(e < 0 or e >= (int)edges.size())
+		return GRAPH_NO_EDGE;
+
+	edge = edges[e];
+	return GRAPH_OK;
+}
+
+GraphStatus Graph::TryGetEdgeIndex(int u, int v, int & e) const noexcept
 {
-	if( u > n or
-		v > n )
-		throw "Error: vertex does not exist";
+	if( u < 0 or u >= n or
+		v < 0 or v >= n )
+		return GRAPH_NO_VERTEX;
 
-	if(adjMat[u][v]) return;
+	int found;
+	try
+	{
+		found = FindEdge(u, v);
+	}
+	catch(const bad_alloc &)
+	{
+		return GRAPH_NO_MEMORY;
+	}
+	if(found == -1)
+		return GRAPH_NO_EDGE;
+
+	e = found;
+	return GRAPH_OK;
+}
+
+GraphStatus Graph::TryAddEdge(int u, int v) noexcept
+{
+	if( u < 0 or u >= n or
+		v < 0 or v >= n )
+		return GRAPH_NO_VERTEX;
+
+	long long key = ((long long) min(u, v) << 32) | (unsigned int) max(u, v);
+	try
+	{
+		if(not edgeSet.insert(key).second) return GRAPH_OK;
+	}
+	catch(const bad_alloc &)
+	{
+		return GRAPH_NO_MEMORY;
+	}
+
+	try
+	{
+		edges.push_back(pair<int, int>(u, v));
+	}
+	catch(const bad_alloc &)
+	{
+		//Keep the edge set in line with the edges
+		edgeSet.erase(key);
+		return GRAPH_NO_MEMORY;
+	}
+	m++;
+	frozen = false;
+	return GRAPH_OK;
+}
 
-	adjMat[u][v] = adjMat[v][u] = true;
-	adjList[u].push_back(v);
-	adjList[v].push_back(u);
+GraphStatus Graph::TryAdjList(int v, span<const int> & adj) const noexcept
+{
+	if(v < 0 or v >= n)
+		return GRAPH_NO_VERTEX;
 
-	edges.push_back(pair<int, int>(u, v));
-	edgeIndex[u][v] = edgeIndex[v][u] = m++;
+	try
+	{
+		Freeze();
+	}
+	catch(const bad_alloc &)
+	{
+		return GRAPH_NO_MEMORY;
+	}
+	adj = span<const int>(adjVertex.data() + adjStart[v], adjStart[v+1] - adjStart[v]);
+	return GRAPH_OK;
 }
 
-const list<int> & Graph::AdjList(int v) const
+GraphStatus Graph::TryAdjEdges(int v, span<const int> & adj) const noexcept
 {
-	if(v > n)
-		throw "Error: vertex does not exist";
+	if(v < 0 or v >= n)
+		return GRAPH_NO_VERTEX;
 
-	return adjList[v];
+	try
+	{
+		Freeze();
+	}
+	catch(const bad_alloc &)
+	{
+		return GRAPH_NO_MEMORY;
+	}
+	adj = span<const int>(adjEdge.data() + adjStart[v], adjStart[v+1] - adjStart[v]);
+	return GRAPH_OK;
 }
 
-const vector< vector<bool> > & Graph::AdjMat() const
+const char * Graph::StatusMessage(GraphStatus status) noexcept
 {
-	return adjMat;
+	switch(status)
+	{
+		case GRAPH_NO_VERTEX:
+			return "Error: vertex does not exist";
+		case GRAPH_NO_EDGE:
+			return "Error: edge does not exist";
+		case GRAPH_NO_MEMORY:
+			return "Error: out of memory";
+		default:
+			return "";
+	}
 }
 
+void Graph::ThrowStatus(GraphStatus status)
+{
+	if(status == GRAPH_NO_MEMORY)
+		throw bad_alloc();
+
+	throw StatusMessage(status);
+}
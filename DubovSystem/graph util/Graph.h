@@ -1,9 +1,22 @@
 #pragma once
 
 #include <list>
+#include <span>
+#include <unordered_set>
 #include <vector>
 using namespace std;
 
+//Status returned by the no-throw versions of the graph functions
+enum GraphStatus
+{
+	GRAPH_OK,
+	GRAPH_NO_VERTEX,
+	GRAPH_NO_EDGE,
+	GRAPH_NO_MEMORY
+};
+
+//The graph is built by adding vertices and edges, and is then frozen into compressed sparse row (CSR) arrays
+//Freezing happens on the first query after the graph changed, so callers never have to do it themselves
 class Graph
 {
 public:
@@ -23,32 +36,60 @@ public:
 	pair<int, int> GetEdge(int e) const;
 	//Given the endpoints, returns the index
 	int GetEdgeIndex(int u, int v) const;
+	//Given the endpoints, returns the index, or -1 if there is no such edge
+	int FindEdge(int u, int v) const;
 
 	//Adds a new vertex to the graph
 	void AddVertex();
 	//Adds a new edge to the graph
 	void AddEdge(int u, int v);
 
-	//Returns the adjacency list of a vertex
-	const list<int> & AdjList(int v) const;
+	//Returns the adjacency list of a vertex (in the order the edges were added)
+	span<const int> AdjList(int v) const;
+	//Returns the indices of the edges of a vertex, lined up with AdjList
+	span<const int> AdjEdges(int v) const;
 
-	//Returns the graph's adjacency matrix
-	const vector< vector<bool> > & AdjMat() const;
+	//Builds the CSR arrays from the edges added so far (does nothing if they are up to date)
+	void Freeze() const;
+
+	//No-throw versions of the functions above, which return a status instead of throwing
+	//The output parameter is only set when the status is GRAPH_OK
+	//Adding an edge and the first query after a change allocate, and running out of memory gives GRAPH_NO_MEMORY
+	GraphStatus TryGetEdge(int e, pair<int, int> & edge) const noexcept;
+	GraphStatus TryGetEdgeIndex(int u, int v, int & e) const noexcept;
+	GraphStatus TryAddEdge(int u, int v) noexcept;
+	GraphStatus TryAdjList(int v, span<const int> & adj) const noexcept;
+	GraphStatus TryAdjEdges(int v, span<const int> & adj) const noexcept;
+
+	//The error message the throwing versions use for a status
+	static const char * StatusMessage(GraphStatus status) noexcept;
 private:
+	//Throws what the throwing versions have always thrown for a status (bad_alloc when out of memory, the message otherwise)
+	static void ThrowStatus(GraphStatus status);
+
 	//Number of vertices
 	int n;
 	//Number of edges
 	int m;
 
-	//Adjacency matrix
-	vector< vector<bool> > adjMat;
-
-	//Adjacency lists
-	vector< list<int> > adjList;
-
 	//Array of edges
 	vector< pair<int, int> > edges;
 
-	//Indices of the edges
-	vector< vector<int> > edgeIndex;
+	//Edges added so far, keyed by both endpoints (only used to skip duplicate edges while building)
+	unordered_set<long long> edgeSet;
+
+	//If the CSR arrays below match the edges
+	mutable bool frozen = false;
+
+	//adjStart[v] is where the neighbors of v start in adjVertex and adjEdge
+	mutable vector<int> adjStart;
+	//Neighbors of each vertex, in the order the edges were added
+	mutable vector<int> adjVertex;
+	//Index of the edge to each neighbor in adjVertex
+	mutable vector<int> adjEdge;
+
+	//Neighbors of each vertex sorted by vertex, for looking up edges with a binary search
+	mutable vector<int> sortedVertex;
+	//Index of the edge to each neighbor in sortedVertex
+	mutable vector<int> sortedEdge;
 };
@@ -3,8 +3,10 @@
  */
 
 #include "Matching.h"
+#include <algorithm>
 
-Matching::Matching(const Graph & G):
+template<class CostType>
+Matching<CostType>::Matching(const Graph & G):
 	G(G),
 	outer(2*G.GetNumVertices()),
 	deep(2*G.GetNumVertices()),
@@ -20,33 +22,42 @@ Matching::Matching(const Graph & G):
 	mate(2*G.GetNumVertices()),
 	m(G.GetNumEdges()),
 	n(G.GetNumVertices()),
-	visited(2*G.GetNumVertices())
+	forestQueue(3*G.GetNumVertices()),
+	forestHead(0),
+	forestTail(0),
+	visited(2*G.GetNumVertices()),
+	isInPath(2*G.GetNumVertices(), false),
+	isInMate(G.GetNumVertices(), false)
 {
+	//Build the CSR arrays once up front, so the solver only ever reads them
+	G.Freeze();
 }
 
-void Matching::Grow()
+template<class CostType>
+void Matching<CostType>::Grow()
 {
 	Reset();
 
 	//All unmatched vertices will be roots in a forest that will be grown
 	//The forest is grown by extending a unmatched vertex w through a matched edge u-v in a BFS fashion
-	while(!forestList.empty())
+	while(forestHead < forestTail)
 	{
-		int w = outer[forestList.front()];
-		forestList.pop_front();
+		int w = outer[forestQueue[forestHead++]];
 
 		//w might be a blossom
 		//we have to explore all the connections from vertices inside the blossom to other vertices
-		for(list<int>::iterator it = deep[w].begin(); it != deep[w].end(); it++)
+		for(int d = 0; d < (int) deep[w].size(); d++)
 		{
-			int u = *it;
+			int u = deep[w][d];
 
 			int cont = false;
-			for(list<int>::const_iterator jt = G.AdjList(u).begin(); jt != G.AdjList(u).end(); jt++)
+			span<const int> adj = G.AdjList(u);
+			span<const int> adjEdges = G.AdjEdges(u);
+			for(int j = 0; j < (int) adj.size(); j++)
 			{
-				int v = *jt;
+				int v = adj[j];
 
-				if(IsEdgeBlocked(u, v)) continue;
+				if(IsEdgeBlocked(adjEdges[j])) continue;
 
 				//u is even and v is odd
 				if(type[outer[v]] == ODD) continue;	
@@ -66,7 +77,7 @@ void Matching::Grow()
 
 					if(!visited[outer[vm]])
 					{
-						forestList.push_back(vm);
+						forestQueue[forestTail++] = vm;
 						visited[outer[vm]] = true;
 					}
 				}
@@ -77,6 +88,10 @@ void Matching::Grow()
 					Augment(u,v);
 					Reset();
 
+					//Give up if the caller no longer wants the answer, which leaves the matching short of perfect
+					if(stop and stop())
+						forestHead = forestTail;
+
 					cont = true;
 					break;
 				}
@@ -86,7 +101,7 @@ void Matching::Grow()
 				{
 					int b = Blossom(u,v);
 
-					forestList.push_front(b);
+					forestQueue[--forestHead] = b;
 					visited[b] = true;
 
 					cont = true;
@@ -104,24 +119,29 @@ void Matching::Grow()
 			perfect = false;
 }
 
-bool Matching::IsAdjacent(int u, int v)
+template<class CostType>
+bool Matching<CostType>::IsAdjacent(int u, int v)
 {
-	return (G.AdjMat()[u][v] and not IsEdgeBlocked(u, v));
+	int e = G.FindEdge(u, v);
+	return (e != -1 and not IsEdgeBlocked(e));
 }
 
-bool Matching::IsEdgeBlocked(int u, int v)
+template<class CostType>
+bool Matching<CostType>::IsEdgeBlocked(int u, int v)
 {
-	return GREATER(slack[ G.GetEdgeIndex(u, v) ], 0);
+	return Greater(slack[ G.GetEdgeIndex(u, v) ], 0);
 }
 
-bool Matching::IsEdgeBlocked(int e)
+template<class CostType>
+bool Matching<CostType>::IsEdgeBlocked(int e)
 {
-	return GREATER(slack[e], 0);
+	return Greater(slack[e], 0);
 }
 
 //Vertices will be selected in non-decreasing order of their degree
 //Each time an unmatched vertex is selected, it is matched to its adjacent unmatched vertex of minimum degree
-void Matching::Heuristic()
+template<class CostType>
+void Matching<CostType>::Heuristic()
 {
 	vector<int> degree(n, 0);
 	BinaryHeap B;
@@ -147,11 +167,13 @@ void Matching::Heuristic()
 		if(mate[outer[u]] == -1)
 		{
 			int min = -1;
-			for(list<int>::const_iterator it = G.AdjList(u).begin(); it != G.AdjList(u).end(); it++)
+			span<const int> adj = G.AdjList(u);
+			span<const int> adjEdges = G.AdjEdges(u);
+			for(int j = 0; j < (int) adj.size(); j++)
 			{
-				int v = *it;
+				int v = adj[j];
 
-				if(IsEdgeBlocked(u, v) or
+				if(IsEdgeBlocked(adjEdges[j]) or
 					(outer[u] == outer[v]) or
 					(mate[outer[v]] != -1) )
 					continue;
@@ -169,17 +191,18 @@ void Matching::Heuristic()
 }
 
 //Destroys a blossom recursively
-void Matching::DestroyBlossom(int t)
+template<class CostType>
+void Matching<CostType>::DestroyBlossom(int t)
 {
 	if((t < n) or
-		(blocked[t] and GREATER(dual[t], 0))) return;
+		(blocked[t] and Greater(dual[t], 0))) return;
 
-	for(list<int>::iterator it = shallow[t].begin(); it != shallow[t].end(); it++)
+	for(int i = 0; i < (int) shallow[t].size(); i++)
 	{
-		int s = *it;
+		int s = shallow[t][i];
 		outer[s] = s;
-		for(list<int>::iterator jt = deep[s].begin(); jt != deep[s].end(); jt++)
-			outer[*jt] = s;	
+		for(int j = 0; j < (int) deep[s].size(); j++)
+			outer[deep[s][j]] = s;
 
 		DestroyBlossom(s);
 	}
@@ -190,7 +213,8 @@ void Matching::DestroyBlossom(int t)
 	mate[t] = -1;
 }
 
-void Matching::Expand(int u, bool expandBlocked = false)
+template<class CostType>
+void Matching<CostType>::Expand(int u, bool expandBlocked)
 {
 	int v = outer[mate[u]];
 
@@ -198,17 +222,56 @@ void Matching::Expand(int u, bool expandBlocked = false)
 	int p = -1, q = -1;
 	//Find the regular edge {p,q} of minimum index connecting u and its mate
 	//We use the minimum index to grant that the two possible blossoms u and v will use the same edge for a mate
-	for(list<int>::iterator it = deep[u].begin(); it != deep[u].end(); it++)
-	{	
-		int di = *it;
-		for(list<int>::iterator jt = deep[v].begin(); jt != deep[v].end(); jt++)
+	//For big blossoms, going through the edges of the smaller one looks at far fewer edges than trying every pair
+	const vector<int> & small = deep[u].size() <= deep[v].size() ? deep[u] : deep[v];
+	const vector<int> & large = deep[u].size() <= deep[v].size() ? deep[v] : deep[u];
+	long long edgesOut = 0;
+	for(int i = 0; i < (int) small.size(); i++)
+		edgesOut += G.AdjList(small[i]).size();
+	if(edgesOut < (long long) small.size() * (long long) large.size())
+	{
+		for(int j = 0; j < (int) large.size(); j++)
+			isInMate[large[j]] = true;
+
+		for(int i = 0; i < (int) small.size(); i++)
+		{
+			int di = small[i];
+			span<const int> adj = G.AdjList(di);
+			span<const int> adjEdges = G.AdjEdges(di);
+			for(int j = 0; j < (int) adj.size(); j++)
+			{
+				int e = adjEdges[j];
+				if(isInMate[adj[j]] and not IsEdgeBlocked(e) and e < index)
+				{
+					index = e;
+					p = di;
+					q = adj[j];
+				}
+			}
+		}
+
+		for(int j = 0; j < (int) large.size(); j++)
+			isInMate[large[j]] = false;
+
+		//p was found on the smaller side, which might be v
+		if(&small != &deep[u])
+			swap(p, q);
+	}
+	else
+	{
+		for(int i = 0; i < (int) deep[u].size(); i++)
 		{
-			int dj = *jt;
-			if(IsAdjacent(di, dj) and G.GetEdgeIndex(di, dj) < index)
+			int di = deep[u][i];
+			for(int j = 0; j < (int) deep[v].size(); j++)
 			{
-				index = G.GetEdgeIndex(di, dj);
-				p = di;
-				q = dj;
+				int dj = deep[v][j];
+				int e = G.FindEdge(di, dj);
+				if(e != -1 and not IsEdgeBlocked(e) and e < index)
+				{
+					index = e;
+					p = di;
+					q = dj;
+				}
 			}
 		}
 	}
@@ -218,59 +281,54 @@ void Matching::Expand(int u, bool expandBlocked = false)
 	//If u is a regular vertex, we are done
 	if(u < n or (blocked[u] and not expandBlocked)) return;
 
+	vector<int> & circuit = shallow[u];
+
+	//Find the position t of the new tip of the blossom (the sub blossom containing p)
+	int t = 0;
 	bool found = false;
-	//Find the position t of the new tip of the blossom
-	for(list<int>::iterator it = shallow[u].begin(); it != shallow[u].end() and not found; )
+	for(; t < (int) circuit.size() and not found; t++)
 	{
-		int si = *it;
-		for(list<int>::iterator jt = deep[si].begin(); jt != deep[si].end() and not found; jt++)
+		int si = circuit[t];
+		for(int j = 0; j < (int) deep[si].size() and not found; j++)
 		{
-			if(*jt == p )
+			if(deep[si][j] == p )
 				found = true;
 		}
-		it++;
-		if(not found)
-		{
-			shallow[u].push_back(si);
-			shallow[u].pop_front();
-		}
 	}
+	//Rotate the circuit so the new tip comes first
+	if(found)
+		rotate(circuit.begin(), circuit.begin() + (t - 1), circuit.end());
 	
-	list<int>::iterator it = shallow[u].begin();
 	//Adjust the mate of the tip
-	mate[*it] = mate[u];
-	it++;
+	mate[circuit[0]] = mate[u];
 	//
 	//Now we go through the odd circuit adjusting the new mates
-	while(it != shallow[u].end())
+	for(int i = 1; i + 1 < (int) circuit.size(); i += 2)
 	{
-		list<int>::iterator itnext = it;
-		itnext++;
-		mate[*it] = *itnext;
-		mate[*itnext] = *it;
-		itnext++;
-		it = itnext;
+		mate[circuit[i]] = circuit[i+1];
+		mate[circuit[i+1]] = circuit[i];
 	}
 
 	//We update the sets blossom, shallow, and outer since this blossom is being deactivated
-	for(list<int>::iterator it = shallow[u].begin(); it != shallow[u].end(); it++)
+	for(int i = 0; i < (int) circuit.size(); i++)
 	{
-		int s = *it;
+		int s = circuit[i];
 		outer[s] = s;
-		for(list<int>::iterator jt = deep[s].begin(); jt != deep[s].end(); jt++)
-			outer[*jt] = s;	
+		for(int j = 0; j < (int) deep[s].size(); j++)
+			outer[deep[s][j]] = s;
 	}
 	active[u] = false;
 	AddFreeBlossomIndex(u);
 	
 	//Expand the vertices in the blossom
-	for(list<int>::iterator it = shallow[u].begin(); it != shallow[u].end(); it++)
-		Expand(*it, expandBlocked);
+	for(int i = 0; i < (int) circuit.size(); i++)
+		Expand(circuit[i], expandBlocked);
 
 }
 
 //Augment the path root[u], ..., u, v, ..., root[v]
-void Matching::Augment(int u, int v)
+template<class CostType>
+void Matching<CostType>::Augment(int u, int v)
 {
 	//We go from u and v to its respective roots, alternating the matching
 	int p = outer[u];
@@ -308,7 +366,8 @@ void Matching::Augment(int u, int v)
 	}
 }
 
-void Matching::Reset()
+template<class CostType>
+void Matching<CostType>::Reset()
 {
 	for(int i = 0; i < 2*n; i++)
 	{
@@ -320,33 +379,37 @@ void Matching::Reset()
 	}
 
 	visited.assign(2*n, 0);
-	forestList.clear();
+	//Blossoms go in at the front of the queue, and there are at most n of them, so the queue starts n slots in
+	forestHead = forestTail = n;
 	for(int i = 0; i < n; i++)
 	{
 		if(mate[outer[i]] == -1)
 		{
 			type[outer[i]] = 2;
 			if(!visited[outer[i]])
-				forestList.push_back(i);
+				forestQueue[forestTail++] = i;
 			visited[outer[i]] = true;
 		}
 		else type[outer[i]] = 0;
 	}
 }
 
-int Matching::GetFreeBlossomIndex()
+template<class CostType>
+int Matching<CostType>::GetFreeBlossomIndex()
 {
 	int i = free.back();
 	free.pop_back();
 	return i;
 }
 
-void Matching::AddFreeBlossomIndex(int i)
+template<class CostType>
+void Matching<CostType>::AddFreeBlossomIndex(int i)
 {
 	free.push_back(i);
 }
 
-void Matching::ClearBlossomIndices()
+template<class CostType>
+void Matching<CostType>::ClearBlossomIndices()
 {
 	free.clear();
 	for(int i = n; i < 2*n; i++)
@@ -354,12 +417,11 @@ void Matching::ClearBlossomIndices()
 }
 
 //Contracts the blossom w, ..., u, v, ..., w, where w is the first vertex that appears in the paths from u and v to their respective roots
-int Matching::Blossom(int u, int v)
+template<class CostType>
+int Matching<CostType>::Blossom(int u, int v)
 {
 	int t = GetFreeBlossomIndex();
 
-	vector<bool> isInPath(2*n, false);
-
 	//Find the tip of the blossom
 	int u_ = u; 
 	while(u_ != -1)
@@ -374,23 +436,27 @@ int Matching::Blossom(int u, int v)
 		v_ = outer[forest[v_]];
 	tip[t] = v_;
 
-	//Find the odd circuit, update shallow, outer, blossom and deep
-	//First we construct the set shallow (the odd circuit)
-	list<int> circuit;
-	u_ = outer[u];
-	circuit.push_front(u_);
-	while(u_ != tip[t])
+	//Unmark the path again, so isInPath is all false for the next blossom
+	u_ = u;
+	while(u_ != -1)
 	{
-		u_ = outer[forest[u_]];
-		circuit.push_front(u_);
+		isInPath[outer[u_]] = false;
+
+		u_ = forest[outer[u_]];
 	}
 
+	//Find the odd circuit, update shallow, outer, blossom and deep
+	//First we construct the set shallow (the odd circuit), from the tip down to u
 	shallow[t].clear();
 	deep[t].clear();
-	for(list<int>::iterator it = circuit.begin(); it != circuit.end(); it++)
+	u_ = outer[u];
+	shallow[t].push_back(u_);
+	while(u_ != tip[t])
 	{
-		shallow[t].push_back(*it);
+		u_ = outer[forest[u_]];
+		shallow[t].push_back(u_);
 	}
+	reverse(shallow[t].begin(), shallow[t].end());
 
 	v_ = outer[v];
 	while(v_ != tip[t])
@@ -400,14 +466,14 @@ int Matching::Blossom(int u, int v)
 	}
 
 	//Now we construct deep and update outer
-	for(list<int>::iterator it = shallow[t].begin(); it != shallow[t].end(); it++)
+	for(int i = 0; i < (int) shallow[t].size(); i++)
 	{
-		u_ = *it;
+		u_ = shallow[t][i];
 		outer[u_] = t;
-		for(list<int>::iterator jt = deep[u_].begin(); jt != deep[u_].end(); jt++)
+		for(int j = 0; j < (int) deep[u_].size(); j++)
 		{
-			deep[t].push_back(*jt);
-			outer[*jt] = t;
+			deep[t].push_back(deep[u_][j]);
+			outer[deep[u_][j]] = t;
 		}
 	}
 
@@ -421,9 +487,10 @@ int Matching::Blossom(int u, int v)
 	return t;
 }
 
-void Matching::UpdateDualCosts()
+template<class CostType>
+void Matching<CostType>::UpdateDualCosts()
 {
-	double e1 = 0, e2 = 0, e3 = 0;
+	CostType e1 = 0, e2 = 0, e3 = 0;
 	int inite1 = false, inite2 = false, inite3 = false;
 	for(int i = 0; i < m; i++)
 	{
@@ -432,7 +499,7 @@ void Matching::UpdateDualCosts()
 
 		if( (type[outer[u]] == EVEN and type[outer[v]] == UNLABELED) or (type[outer[v]] == EVEN and type[outer[u]] == UNLABELED) )
 		{
-			if(!inite1 or GREATER(e1, slack[i]))
+			if(!inite1 or Greater(e1, slack[i]))
 			{
 				e1 = slack[i];
 				inite1 = true;
@@ -440,7 +507,7 @@ void Matching::UpdateDualCosts()
 		}
 		else if( (outer[u] != outer[v]) and type[outer[u]] == EVEN and type[outer[v]] == EVEN )
 		{
-			if(!inite2 or GREATER(e2, slack[i]))
+			if(!inite2 or Greater(e2, slack[i]))
 			{
 				e2 = slack[i];
 				inite2 = true;
@@ -449,20 +516,20 @@ void Matching::UpdateDualCosts()
 	}
 	for(int i = n; i < 2*n; i++)
 	{
-		if(active[i] and i == outer[i] and type[outer[i]] == ODD and (!inite3 or GREATER(e3, dual[i])))
+		if(active[i] and i == outer[i] and type[outer[i]] == ODD and (!inite3 or Greater(e3, dual[i])))
 		{
 			e3 = dual[i]; 
 			inite3 = true;
 		}	
 	}
-	double e = 0;
+	CostType e = 0;
 	if(inite1) e = e1;
 	else if(inite2) e = e2;
 	else if(inite3) e = e3;
 
-	if(GREATER(e, e2/2.0) and inite2)
-		e = e2/2.0;
-	if(GREATER(e, e3) and inite3)
+	if(Greater(e, e2/2) and inite2)
+		e = e2/2;
+	if(Greater(e, e3) and inite3)
 		e = e3;
 	 
 	for(int i = 0; i < 2*n; i++)
@@ -487,9 +554,9 @@ void Matching::UpdateDualCosts()
 		if(outer[u] != outer[v])
 		{	
 			if(type[outer[u]] == EVEN and type[outer[v]] == EVEN)
-				slack[i] -= 2.0*e;
+				slack[i] -= 2*e;
 			else if(type[outer[u]] == ODD and type[outer[v]] == ODD)
-				slack[i] += 2.0*e;
+				slack[i] += 2*e;
 			else if( (type[outer[v]] == UNLABELED and type[outer[u]] == EVEN) or (type[outer[u]] == UNLABELED and type[outer[v]] == EVEN) )
 				slack[i] -= e;
 			else if( (type[outer[v]] == UNLABELED and type[outer[u]] == ODD) or (type[outer[u]] == UNLABELED and type[outer[v]] == ODD) )
@@ -498,7 +565,7 @@ void Matching::UpdateDualCosts()
 	}
 	for(int i = n; i < 2*n; i++)
 	{
-		if(GREATER(dual[i], 0))
+		if(Greater(dual[i], 0))
 		{
 			blocked[i] = true;
 		}
@@ -518,16 +585,19 @@ void Matching::UpdateDualCosts()
 	}	
 }
 
-pair< list<int>, double> Matching::SolveMinimumCostPerfectMatching(const vector<double> & cost)
+template<class CostType>
+pair< vector<int>, CostType > Matching<CostType>::SolveMinimumCostPerfectMatching(const vector<CostType> & cost)
 {
 	SolveMaximumMatching();
 	if(!perfect)
-        return make_pair(list<int>(), -1); // just a small change to the original source so it is easier to capture this error
+        return make_pair(vector<int>(), -1); // just a small change to the original source so it is easier to capture this error
 
 	Clear();
 
 	//Initialize slacks (reduced costs for the edges)
-	slack = cost;
+	//Integer costs are doubled, so halving a slack in UpdateDualCosts stays exact
+	for(int i = 0; i < m; i++)
+		slack[i] = Scale * cost[i];
 
 	PositiveCosts();
 
@@ -535,6 +605,10 @@ pair< list<int>, double> Matching::SolveMinimumCostPerfectMatching(const vector<
 	perfect = false;
 	while(not perfect)
 	{
+		//Give up if the caller no longer wants the answer
+		if(stop and stop())
+			return make_pair(vector<int>(), -1);
+
 		//Run an heuristic maximum matching algorithm
 		Heuristic();
 		//Grow a hungarian forest
@@ -544,42 +618,115 @@ pair< list<int>, double> Matching::SolveMinimumCostPerfectMatching(const vector<
 		Reset();
 	}
 
-	list<int> matching = RetrieveMatching();
+	SaveBlossoms();
+	vector<int> matching = RetrieveMatching();
 
-	double obj = 0;
-	for(list<int>::iterator it = matching.begin(); it != matching.end(); it++)
-		obj += cost[*it];
+	CostType obj = 0;
+	for(int i = 0; i < (int) matching.size(); i++)
+		obj += cost[matching[i]];
 	
-	double dualObj = 0;
+	CostType dualObj = 0;
 	for(int i = 0; i < 2*n; i++)
 	{
 		if(i < n) dualObj += dual[i];
 		else if(blocked[i]) dualObj += dual[i];	
 	}
 	
-	return pair< list<int>, double >(matching, obj);
+	return pair< vector<int>, CostType >(matching, obj);
 }
 
-void Matching::PositiveCosts()
+template<class CostType>
+void Matching<CostType>::PositiveCosts()
 {
-	double minEdge = 0;
+	CostType minEdge = 0;
 	for(int i = 0; i < m ;i++)
-		if(GREATER(minEdge - slack[i], 0)) 
+		if(Greater(minEdge - slack[i], 0)) 
 			minEdge = slack[i];
 
 	for(int i = 0; i < m; i++)
 		slack[i] -= minEdge;
+
+	shift = minEdge;
+}
+
+template<class CostType>
+void Matching<CostType>::SaveBlossoms()
+{
+	blossomChain.assign(n, vector<int>());
+	inBlossoms.assign(n, 0);
+
+	//Walk down from every outermost blossom
+	vector<int> chain;
+	for(int t = n; t < 2*n; t++)
+		if(active[t] and outer[t] == t)
+			SaveBlossoms(t, chain);
+}
+
+template<class CostType>
+void Matching<CostType>::SaveBlossoms(int t, vector<int> & chain)
+{
+	if(t < n)
+	{
+		blossomChain[t] = chain;
+		for(int i = 0; i < (int) chain.size(); i++)
+			inBlossoms[t] += dual[chain[i]];
+		return;
+	}
+
+	chain.push_back(t);
+	for(int i = 0; i < (int) shallow[t].size(); i++)
+		SaveBlossoms(shallow[t][i], chain);
+	chain.pop_back();
 }
 
-list<int> Matching::SolveMaximumMatching()
+template<class CostType>
+bool Matching<CostType>::IsDualFeasible(int u, int v, CostType cost) const
+{
+	//The dual of a blossom only counts for an edge with one end inside it
+	//The blossoms holding both ends are the same first few on both chains
+	const vector<int> & cu = blossomChain[u];
+	const vector<int> & cv = blossomChain[v];
+	CostType both = 0;
+	for(int i = 0; i < (int) min(cu.size(), cv.size()) and cu[i] == cv[i]; i++)
+		both += dual[cu[i]];
+
+	CostType reduced = Scale * cost - shift - dual[u] - dual[v] - (inBlossoms[u] - both) - (inBlossoms[v] - both);
+	return not Greater(0, reduced);
+}
+
+template<class CostType>
+vector<int> Matching<CostType>::SolveMaximumMatching()
 {
 	Clear();
+
+	//Start from the seed, so only the vertices it leaves unmatched need augmenting paths
+	for(int i = 0; i < (int) seed.size(); i++)
+	{
+		int u = seed[i].first;
+		int v = seed[i].second;
+
+		if(u < 0 or v < 0 or u >= n or v >= n or u == v) continue;
+		if(mate[u] != -1 or mate[v] != -1) continue;
+		if(G.FindEdge(u, v) == -1) continue;
+
+		mate[u] = v;
+		mate[v] = u;
+	}
+
 	Grow();
-	return RetrieveMatching();
+	maximum = RetrieveMatching();
+	return maximum;
+}
+
+template<class CostType>
+void Matching<CostType>::WarmStart(const vector< pair<int, int> > & pairs)
+{
+	seed = pairs;
 }
 
 //Sets up the algorithm for a new run
-void Matching::Clear()
+template<class CostType>
+void Matching<CostType>::Clear()
 {
 	ClearBlossomIndices();
 
@@ -605,9 +752,10 @@ void Matching::Clear()
 	slack.assign(m, 0);
 }
 
-list<int> Matching::RetrieveMatching()
+template<class CostType>
+vector<int> Matching<CostType>::RetrieveMatching()
 {
-	list<int> matching;
+	vector<int> matching;
 
 	for(int i = 0; i < 2*n; i++)
 		if(active[i] and mate[i] != -1 and outer[i] == i)
@@ -623,3 +771,8 @@ list<int> Matching::RetrieveMatching()
 	}
 	return matching;
 }
+
+//The cost types used: double for general use, exact integers for the pairing engine, and long long for the whole round matching
+template class Matching<double>;
+template class Matching<int>;
+template class Matching<long long>;
@@ -2,7 +2,8 @@
 
 #include "Graph.h"
 #include "BinaryHeap.h"
-#include <list>
+#include <functional>
+#include <type_traits>
 #include <vector>
 using namespace std;
 
@@ -10,6 +11,9 @@ using namespace std;
 #define ODD 1
 #define UNLABELED 0
 
+//CostType is the type of the edge costs
+//Integer costs are solved exactly (no epsilon comparisons), floating point costs use the tolerances in Globals.h
+template<class CostType = double>
 class Matching
 {
 public:
@@ -18,22 +22,38 @@ public:
 
 	//Solves the minimum cost perfect matching problem
 	//Receives the a vector whose position i has the cost of the edge with index i
-	//If the graph doest not have a perfect matching, a const char * exception will be raised
+	//If the graph doest not have a perfect matching, the vector of edges is empty and the cost is -1
 	//Returns a pair
-	//the first element of the pair is a list of the indices of the edges in the matching
+	//the first element of the pair is a vector of the indices of the edges in the matching
 	//the second is the cost of the matching
-	pair< list<int>, double > SolveMinimumCostPerfectMatching(const vector<double> & cost);
+	pair< vector<int>, CostType > SolveMinimumCostPerfectMatching(const vector<CostType> & cost);
 
 	//Solves the maximum cardinality matching problem
-	//Returns a list with the indices of the edges in the matching
-	list<int> SolveMaximumMatching();
+	//Returns a vector with the indices of the edges in the matching
+	vector<int> SolveMaximumMatching();
+
+	//Gives a matching to start the maximum cardinality search from (usually the matching of a similar graph solved before)
+	//Pairs that are not edges of the graph, or that share a vertex with an earlier pair, are ignored
+	//Only the search for a perfect matching is warm started, so the minimum cost matching found is the same as without it
+	void WarmStart(const vector< pair<int, int> > & pairs);
+	//Returns the maximum cardinality matching found by the last solve (the perfect matching check of SolveMinimumCostPerfectMatching included)
+	const vector<int> & GetMaximumMatching() const { return maximum; };
+
+	//Gives a check that is called after every augmenting path and before every grow step of the minimum cost solve
+	//Once it returns true the solve gives up and returns the same as when there is no perfect matching (the maximum matching search stops short as well)
+	void SetStop(const function<bool()> & check) { stop = check; };
+
+	//Checks if an edge u-v with the given cost, in the graph or not, keeps the dual costs of the last solve feasible
+	//Only valid after a solve that found a perfect matching
+	//If every edge left out of the graph passes, the matching found is also a minimum cost perfect matching of the graph with those edges added
+	bool IsDualFeasible(int u, int v, CostType cost) const;
 
 private:
 	//Grows an alternating forest
 	void Grow();
 	//Expands a blossom u
 	//If expandBlocked is true, the blossom will be expanded even if it is blocked
-	void Expand(int u, bool expandBlocked);
+	void Expand(int u, bool expandBlocked = false);
 	//Augments the matching using the path from u to v in the alternating forest
 	void Augment(int u, int v);
 	//Resets the alternating forest
@@ -48,7 +68,10 @@ private:
 	void Heuristic();
 	//Modifies the costs of the graph so the all edges have positive costs
 	void PositiveCosts();
-	list<int> RetrieveMatching();
+	//Saves the blossoms every vertex is in, since RetrieveMatching takes the blossoms apart
+	void SaveBlossoms();
+	void SaveBlossoms(int t, vector<int> & chain);
+	vector<int> RetrieveMatching();
 
 	int GetFreeBlossomIndex();
 	void AddFreeBlossomIndex(int i);
@@ -62,11 +85,11 @@ private:
 
 	const Graph & G;
 
-	list<int> free;//List of free blossom indices
+	vector<int> free;//Stack of free blossom indices
 
 	vector<int> outer;//outer[v] gives the index of the outermost blossom that contains v, outer[v] = v if v is not contained in any blossom
-	vector< list<int> > deep;//deep[v] is a list of all the original vertices contained inside v, deep[v] = v if v is an original vertex
-	vector< list<int> > shallow;//shallow[v] is a list of the vertices immediately contained inside v, shallow[v] is empty is the default
+	vector< vector<int> > deep;//deep[v] is a list of all the original vertices contained inside v, deep[v] = v if v is an original vertex
+	vector< vector<int> > shallow;//shallow[v] is a list of the vertices immediately contained inside v, shallow[v] is empty is the default
 	vector<int> tip;//tip[v] is the tip of blossom v
 	vector<bool> active;//true if a blossom is being used
 
@@ -75,15 +98,48 @@ private:
 	vector<int> root;//root[v] gives the root of v in the alternating forest 
 
 	vector<bool> blocked;//A blossom can be blocked due to dual costs, this means that it behaves as if it were an original vertex and cannot be expanded
-	vector<double> dual;//dual multipliers associated to the blossoms, if dual[v] > 0, the blossom is blocked and full
-	vector<double> slack;//slack associated to each edge, if slack[e] > 0, the edge cannot be used
+	vector<CostType> dual;//dual multipliers associated to the blossoms, if dual[v] > 0, the blossom is blocked and full
+	vector<CostType> slack;//slack associated to each edge, if slack[e] > 0, the edge cannot be used
 	vector<int> mate;//mate[v] gives the mate of v
 
 	int m, n;
 
 	bool perfect;
 
-	list<int> forestList;
+	//Integer costs are scaled by 2 so every dual update stays an integer
+	static constexpr CostType Scale = is_integral<CostType>::value ? 2 : 1;
+	//Compares two costs, exactly for integers and with a tolerance for floating point
+	static bool Greater(CostType a, CostType b)
+	{
+		if constexpr (is_integral<CostType>::value) return a > b;
+		else return GREATER(a, b);
+	}
+
+	//Queue of the vertices to grow the forest from, kept in one flat array
+	//Blossoms are pushed at the front and everything else at the back, so the queue starts n slots in (see Reset)
+	vector<int> forestQueue;
+	int forestHead, forestTail;
 	vector<int> visited;
+	//Marks the outer blossoms on the path from u to its root while a blossom is built, all false otherwise
+	vector<bool> isInPath;
+	//Marks the original vertices of the blossom on the other side while Expand looks for the edge to it, all false otherwise
+	vector<bool> isInMate;
+
+	//Pairs of vertices to start the maximum cardinality search from
+	vector< pair<int, int> > seed;
+	//The last maximum cardinality matching found
+	vector<int> maximum;
+	//Checked after every augmenting path and before every grow step, empty if the solve always runs to the end
+	function<bool()> stop;
+
+	//What PositiveCosts took off every edge
+	CostType shift;
+	//blossomChain[v] lists the blossoms left with v inside after the last solve, from the outermost in
+	vector< vector<int> > blossomChain;
+	//inBlossoms[v] is the sum of the dual costs of the blossoms in blossomChain[v]
+	vector<CostType> inBlossoms;
 };
 
+extern template class Matching<double>;
+extern template class Matching<int>;
+extern template class Matching<long long>;
@@ -47,6 +47,7 @@ void helpDisplay() {
     std::cout << "|--fpc        |Free Pairings Checker        |" << std::endl;
     std::cout << "|--fpc_rounds |(for fpc) Round to check     |" << std::endl;
     std::cout << "|--output     |Output pairings to a file    |" << std::endl;
+    std::cout << "|--engine_diff|Diff global and group engines|" << std::endl;
 }
 
 /**
@@ -61,7 +62,9 @@ void exampleUsage() {
     std::cout << "EXAMPLE USAGE FOR RANDOM TOURNAMENT GENERATOR\n";
     std::cout << "./CPPDubovSystem --rtg path/to/trf/output.trf --p_count 10 --rtg_rounds 5\n\n";
     std::cout << "EXAMPLE USAGE FOR FREE PAIRINGS CHECKER\n";
-    std::cout << "./CPPDubovSystem --fpc path/to/trf/output.trf --fpc_rounds 2" << std::endl;
+    std::cout << "./CPPDubovSystem --fpc path/to/trf/output.trf --fpc_rounds 2\n\n";
+    std::cout << "EXAMPLE USAGE FOR ENGINE DIFF (ANY NUMBER OF FILES)\n";
+    std::cout << "./CPPDubovSystem --engine_diff path/to/first.trf path/to/second.trf" << std::endl;
 }
 
 /**
@@ -213,6 +216,16 @@ int main(int argc, const char * argv[]) {
         std::cout << "Initiating Pairings Checker.\n\n";
         std::cout << pc_main.outputReport();
         return 0;
+    } else if(pair_command == "--engine_diff") {
+        // every argument after the command is a TRF file
+        std::vector<std::string> paths;
+        for(int i = 2; i < argc; i++) {
+            paths.push_back(argv[i]);
+        }
+        fpc::EngineDiff diff(paths);
+        std::cout << "Initiating Engine Diff.\n\n";
+        std::cout << diff.outputReport();
+        return 0;
     }
     if(pair_command != "--pairings") {
         std::cout << "Unknown command passed in" << std::endl;